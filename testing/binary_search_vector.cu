@@ -393,6 +393,53 @@ struct TestVectorBinarySearch
 };
 VariableUnitTest<TestVectorBinarySearch, SignedIntegralTypes> TestVectorBinarySearchInstance;
 
+
+template <typename T>
+struct TestVectorSearchSortedQueries
+{
+  void operator()(const size_t n)
+  {
+    // a table with many duplicates
+    thrust::host_vector<T> h_vec = unittest::random_integers<T>(n);
+    for(size_t i = 0; i < n; i++)
+      h_vec[i] = static_cast<T>(h_vec[i] % 64);
+    thrust::sort(h_vec.begin(), h_vec.end());
+    thrust::device_vector<T> d_vec = h_vec;
+
+    // sorted queries, some of which precede or follow the whole table
+    thrust::host_vector<T> h_input = unittest::random_integers<T>(2*n);
+    for(size_t i = 0; i < 2*n; i++)
+      h_input[i] = static_cast<T>(h_input[i] % 80 - 8);
+    thrust::sort(h_input.begin(), h_input.end());
+
+    // and a few unsorted ones in the middle
+    if(n > 2)
+      thrust::swap(h_input[n - 1], h_input[n + 1]);
+
+    thrust::device_vector<T> d_input = h_input;
+
+    typedef typename thrust::host_vector<T>::difference_type int_type;
+    thrust::host_vector<int_type>   h_output(2*n);
+    thrust::device_vector<int_type> d_output(2*n);
+
+    thrust::lower_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+    thrust::lower_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::upper_bound(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_output.begin());
+    thrust::upper_bound(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_output.begin());
+    ASSERT_EQUAL(h_output, d_output);
+
+    thrust::host_vector<bool>   h_found(2*n);
+    thrust::device_vector<bool> d_found(2*n);
+
+    thrust::binary_search(h_vec.begin(), h_vec.end(), h_input.begin(), h_input.end(), h_found.begin());
+    thrust::binary_search(d_vec.begin(), d_vec.end(), d_input.begin(), d_input.end(), d_found.begin());
+    ASSERT_EQUAL(h_found, d_found);
+  }
+};
+VariableUnitTest<TestVectorSearchSortedQueries, SignedIntegralTypes> TestVectorSearchSortedQueriesInstance;
+
 template <typename T>
 struct TestVectorLowerBoundDiscardIterator
 {
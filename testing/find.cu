@@ -305,6 +305,31 @@ struct TestFindIfNot
 };
 VariableUnitTest<TestFindIfNot, SignedIntegralTypes> TestFindIfNotInstance;
 
+
+template <class Vector>
+void TestFindIfFirstOfManyMatches(void)
+{
+    typedef typename Vector::value_type T;
+
+    const long n = (1 << 20) + 7;
+
+    Vector data(n, T(0));
+
+    // add matches in front of the current first match, so that later blocks
+    // always hold a match too
+    const long positions[] = {n - 1, 700001, 300000, 4097, 4096, 1, 0};
+
+    ASSERT_EQUAL(thrust::find_if(data.begin(), data.end(), equal_to_value_pred<T>(1)) - data.begin(), n);
+
+    for (size_t i = 0; i < sizeof(positions) / sizeof(long); i++)
+    {
+        data[positions[i]] = T(1);
+        ASSERT_EQUAL(thrust::find_if(data.begin(), data.end(), equal_to_value_pred<T>(1)) - data.begin(), positions[i]);
+        ASSERT_EQUAL(thrust::find(data.begin(), data.end(), T(1)) - data.begin(), positions[i]);
+    }
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestFindIfFirstOfManyMatches);
+
 void TestFindWithBigIndexesHelper(int magnitude)
 {
     thrust::counting_iterator<long long> begin(1);
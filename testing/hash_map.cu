@@ -0,0 +1,258 @@
+#include <unittest/unittest.h>
+#include <thrust/hash_map.h>
+#include <thrust/execution_policy.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include <memory>
+
+
+template <class Vector>
+void TestHashMapSimple(void)
+{
+    typedef typename Vector::value_type T;
+    typedef thrust::hash_map<T, T> Map;
+
+    Vector keys(3), values(3);
+
+    keys[0] = 7;  values[0] = 70;
+    keys[1] = 1;  values[1] = 10;
+    keys[2] = 4;  values[2] = 40;
+
+    Map map;
+
+    ASSERT_EQUAL(map.size(), 0lu);
+    ASSERT_EQUAL(map.empty(), true);
+
+    map.insert(keys.begin(), keys.end(), values.begin());
+
+    ASSERT_EQUAL(map.size(), 3lu);
+    ASSERT_EQUAL(map.empty(), false);
+
+    Vector probes(4);
+
+    probes[0] = 4;
+    probes[1] = 5;
+    probes[2] = 7;
+    probes[3] = 7;
+
+    Vector result(4);
+
+    typename Vector::iterator result_end = map.find(probes.begin(), probes.end(), result.begin(), T(-1));
+
+    ASSERT_EQUAL(result_end - result.begin(), 4);
+
+    ASSERT_EQUAL(result[0], T(40));
+    ASSERT_EQUAL(result[1], T(-1));
+    ASSERT_EQUAL(result[2], T(70));
+    ASSERT_EQUAL(result[3], T(70));
+
+    thrust::host_vector<bool> found(4);
+
+    map.contains(thrust::host, probes.begin(), probes.end(), found.begin());
+
+    ASSERT_EQUAL(found[0], true);
+    ASSERT_EQUAL(found[1], false);
+    ASSERT_EQUAL(found[2], true);
+    ASSERT_EQUAL(found[3], true);
+
+    map.clear();
+
+    ASSERT_EQUAL(map.size(), 0lu);
+
+    map.contains(thrust::host, probes.begin(), probes.end(), found.begin());
+
+    ASSERT_EQUAL(found[0], false);
+    ASSERT_EQUAL(found[2], false);
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestHashMapSimple);
+
+
+void TestHashMapDuplicates(void)
+{
+    // the value of the first appearance of a key is inserted, and keys which
+    // are in the map already keep their values
+    thrust::device_vector<int> keys(6), values(6);
+
+    keys[0] = 3;  values[0] = 0;
+    keys[1] = 5;  values[1] = 1;
+    keys[2] = 3;  values[2] = 2;
+    keys[3] = 8;  values[3] = 3;
+    keys[4] = 5;  values[4] = 4;
+    keys[5] = 3;  values[5] = 5;
+
+    thrust::hash_map<int, int> map(2);
+
+    map.insert(keys.begin(), keys.end(), values.begin());
+
+    ASSERT_EQUAL(map.size(), 3lu);
+
+    thrust::device_vector<int> more_keys(2), more_values(2, 9);
+
+    more_keys[0] = 8;
+    more_keys[1] = 6;
+
+    map.insert(more_keys.begin(), more_keys.end(), more_values.begin());
+
+    ASSERT_EQUAL(map.size(), 4lu);
+
+    thrust::device_vector<int> map_keys(4), map_values(4);
+
+    thrust::pair<thrust::device_vector<int>::iterator, thrust::device_vector<int>::iterator> ends =
+      map.copy(map_keys.begin(), map_values.begin());
+
+    ASSERT_EQUAL(ends.first  - map_keys.begin(), 4);
+    ASSERT_EQUAL(ends.second - map_values.begin(), 4);
+
+    thrust::sort_by_key(map_keys.begin(), map_keys.end(), map_values.begin());
+
+    ASSERT_EQUAL(map_keys[0], 3);
+    ASSERT_EQUAL(map_keys[1], 5);
+    ASSERT_EQUAL(map_keys[2], 6);
+    ASSERT_EQUAL(map_keys[3], 8);
+
+    ASSERT_EQUAL(map_values[0], 0);
+    ASSERT_EQUAL(map_values[1], 1);
+    ASSERT_EQUAL(map_values[2], 9);
+    ASSERT_EQUAL(map_values[3], 3);
+}
+DECLARE_UNITTEST(TestHashMapDuplicates);
+
+
+template <typename T>
+struct TestHashMap
+{
+    void operator()(const size_t n)
+    {
+        typedef thrust::hash_map<T, int> Map;
+
+        // keys with duplicates, inserted in two batches so that the map grows
+        // with elements in it
+        thrust::host_vector<T> h_keys = unittest::random_integers<T>(n);
+
+        thrust::device_vector<T>   d_keys = h_keys;
+        thrust::device_vector<int> d_values(n);
+        thrust::sequence(d_values.begin(), d_values.end());
+
+        Map map;
+
+        map.insert(d_keys.begin(), d_keys.begin() + n / 2, d_values.begin());
+        map.insert(d_keys.begin() + n / 2, d_keys.end(), d_values.begin() + n / 2);
+
+        // the expected value of a key is the position of its first appearance
+        thrust::host_vector<T>   h_sorted_keys = h_keys;
+        thrust::host_vector<int> h_positions(n);
+        thrust::sequence(h_positions.begin(), h_positions.end());
+        thrust::stable_sort_by_key(h_sorted_keys.begin(), h_sorted_keys.end(), h_positions.begin());
+
+        size_t num_unique = 0;
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            if(i == 0 || h_sorted_keys[i] != h_sorted_keys[i - 1]) ++num_unique;
+        }
+
+        ASSERT_EQUAL(map.size(), num_unique);
+
+        thrust::device_vector<int> d_result(n);
+
+        map.find(thrust::device, d_keys.begin(), d_keys.end(), d_result.begin());
+
+        thrust::host_vector<int> h_result = d_result;
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            const size_t first = thrust::lower_bound(h_sorted_keys.begin(), h_sorted_keys.end(), h_keys[i]) - h_sorted_keys.begin();
+
+            ASSERT_EQUAL(h_result[i], h_positions[first]);
+        }
+
+        // keys shifted by one half of the range are mostly missing
+        thrust::host_vector<T> h_probes(n);
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            h_probes[i] = T(h_keys[i] + T(1) + (std::numeric_limits<T>::max)() / T(2));
+        }
+
+        thrust::device_vector<T>    d_probes = h_probes;
+        thrust::device_vector<bool> d_found(n);
+
+        map.contains(d_probes.begin(), d_probes.end(), d_found.begin());
+
+        thrust::host_vector<bool> h_found = d_found;
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            ASSERT_EQUAL(h_found[i], thrust::binary_search(h_sorted_keys.begin(), h_sorted_keys.end(), h_probes[i]));
+        }
+    }
+};
+VariableUnitTest<TestHashMap, IntegralTypes> TestHashMapInstance;
+
+
+void TestHashMapManyPartitions(void)
+{
+    // enough keys for the map to be divided into several partitions
+    const int n = 1 << 18;
+
+    thrust::device_vector<long long> keys(n);
+    thrust::sequence(keys.begin(), keys.end(), 0ll, 3ll);
+
+    thrust::device_vector<int> values(n);
+    thrust::sequence(values.begin(), values.end());
+
+    thrust::hash_map<long long, int> map;
+
+    map.reserve(n / 4);
+
+    ASSERT_EQUAL(map.capacity() >= size_t(n / 4), true);
+
+    map.insert(thrust::device, keys.begin(), keys.end(), values.begin());
+
+    ASSERT_EQUAL(map.size(), size_t(n));
+
+    thrust::device_vector<long long> probes(3 * n);
+    thrust::sequence(probes.begin(), probes.end());
+
+    thrust::device_vector<int> result(3 * n);
+
+    map.find(thrust::device, probes.begin(), probes.end(), result.begin(), -1);
+
+    thrust::host_vector<int> h_result = result;
+
+    for(int i = 0; i < 3 * n; ++i)
+    {
+        ASSERT_EQUAL(h_result[i], (i % 3 == 0) ? i / 3 : -1);
+    }
+}
+DECLARE_UNITTEST(TestHashMapManyPartitions);
+
+
+void TestHashMapFloatingPoint(void)
+{
+    // -0 and +0 are the same key
+    thrust::host_vector<double> keys(3);
+
+    keys[0] = 0.0;
+    keys[1] = -0.0;
+    keys[2] = 0.5;
+
+    thrust::host_vector<int> values(3);
+    thrust::sequence(values.begin(), values.end());
+
+    thrust::hash_map<double, int, thrust::detail::arithmetic_hash<double>, thrust::equal_to<double>, std::allocator<double> > map;
+
+    map.insert(thrust::host, keys.begin(), keys.end(), values.begin());
+
+    ASSERT_EQUAL(map.size(), 2lu);
+
+    thrust::host_vector<int> result(3);
+
+    map.find(thrust::host, keys.begin(), keys.end(), result.begin());
+
+    ASSERT_EQUAL(result[0], 0);
+    ASSERT_EQUAL(result[1], 0);
+    ASSERT_EQUAL(result[2], 2);
+}
+DECLARE_UNITTEST(TestHashMapFloatingPoint);
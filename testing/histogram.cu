@@ -0,0 +1,269 @@
+#include <unittest/unittest.h>
+#include <thrust/histogram.h>
+#include <thrust/iterator/retag.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include <algorithm>
+#include <limits>
+
+
+template <class Vector>
+void TestHistogramEvenSimple(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector data(8);
+
+    data[0] =  1;
+    data[1] = 17;
+    data[2] =  4;
+    data[3] =  5;
+    data[4] = 12;
+    data[5] =  0;
+    data[6] = 20;
+    data[7] =  9;
+
+    Vector histogram(4, T(7));
+
+    typename Vector::iterator result = thrust::histogram_even(data.begin(), data.end(), histogram.begin(), 4, T(0), T(20));
+
+    ASSERT_EQUAL(result - histogram.begin(), 4);
+
+    // 20 is past the last bin
+    ASSERT_EQUAL(histogram[0], T(3));
+    ASSERT_EQUAL(histogram[1], T(2));
+    ASSERT_EQUAL(histogram[2], T(1));
+    ASSERT_EQUAL(histogram[3], T(1));
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestHistogramEvenSimple);
+
+
+template <class Vector>
+void TestHistogramRangeSimple(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector data(8);
+
+    data[0] =  1;
+    data[1] = 17;
+    data[2] =  4;
+    data[3] =  5;
+    data[4] = 12;
+    data[5] =  0;
+    data[6] = 20;
+    data[7] =  9;
+
+    Vector levels(4);
+
+    levels[0] =  1;
+    levels[1] =  5;
+    levels[2] =  6;
+    levels[3] = 17;
+
+    Vector histogram(3, T(7));
+
+    typename Vector::iterator result = thrust::histogram_range(data.begin(), data.end(), levels.begin(), levels.end(), histogram.begin());
+
+    ASSERT_EQUAL(result - histogram.begin(), 3);
+
+    // 0 is before the first bin, and 17 and 20 are past the last bin
+    ASSERT_EQUAL(histogram[0], T(2));
+    ASSERT_EQUAL(histogram[1], T(1));
+    ASSERT_EQUAL(histogram[2], T(2));
+
+    // a single level has no bins
+    result = thrust::histogram_range(data.begin(), data.end(), levels.begin(), levels.begin() + 1, histogram.begin());
+
+    ASSERT_EQUAL(result - histogram.begin(), 0);
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestHistogramRangeSimple);
+
+
+template<typename InputIterator, typename RandomAccessIterator, typename Size, typename Level>
+RandomAccessIterator histogram_even(my_system &system, InputIterator, InputIterator, RandomAccessIterator histogram, Size, Level, Level)
+{
+    system.validate_dispatch();
+    return histogram;
+}
+
+void TestHistogramEvenDispatchExplicit()
+{
+    thrust::device_vector<int> vec(1);
+
+    my_system sys(0);
+    thrust::histogram_even(sys,
+                           vec.begin(),
+                           vec.end(),
+                           vec.begin(),
+                           1,
+                           0,
+                           1);
+
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestHistogramEvenDispatchExplicit);
+
+
+template<typename InputIterator, typename RandomAccessIterator1, typename RandomAccessIterator2>
+RandomAccessIterator2 histogram_range(my_tag, InputIterator, InputIterator, RandomAccessIterator1, RandomAccessIterator1, RandomAccessIterator2 histogram)
+{
+    *histogram = 13;
+    return histogram;
+}
+
+void TestHistogramRangeDispatchImplicit()
+{
+    thrust::device_vector<int> vec(1);
+
+    thrust::histogram_range(thrust::retag<my_tag>(vec.begin()),
+                            thrust::retag<my_tag>(vec.end()),
+                            thrust::retag<my_tag>(vec.begin()),
+                            thrust::retag<my_tag>(vec.end()),
+                            thrust::retag<my_tag>(vec.begin()));
+
+    ASSERT_EQUAL(13, vec.front());
+}
+DECLARE_UNITTEST(TestHistogramRangeDispatchImplicit);
+
+
+template <typename T>
+struct TestHistogramEven
+{
+    void operator()(const size_t n)
+    {
+        thrust::host_vector<T>   h_data = unittest::random_integers<T>(n);
+        thrust::device_vector<T> d_data = h_data;
+
+        // a range which leaves samples out on both sides, divided into bins
+        // of uneven integer widths. (upper - lower) * num_bins fits into 64
+        // bits
+        const T divisor = T(sizeof(T) < 8 ? 2 : 32);
+
+        const T lower = T((std::numeric_limits<T>::min)() / divisor + T(3));
+        const T upper = T((std::numeric_limits<T>::max)() / divisor);
+
+        const int num_bins = 13;
+
+        thrust::host_vector<int>   h_histogram(num_bins);
+        thrust::device_vector<int> d_histogram(num_bins);
+
+        thrust::histogram_even(h_data.begin(), h_data.end(), h_histogram.begin(), num_bins, lower, upper);
+        thrust::histogram_even(d_data.begin(), d_data.end(), d_histogram.begin(), num_bins, lower, upper);
+
+        // x - lower falls into bin i when it is at least the offset of bin
+        // i, the smallest integer not less than i * (upper - lower) / num_bins
+        const unsigned long long range = static_cast<unsigned long long>(upper) - static_cast<unsigned long long>(lower);
+
+        thrust::host_vector<unsigned long long> offsets(num_bins);
+
+        for(int i = 0; i < num_bins; ++i)
+        {
+            offsets[i] = (i * range + num_bins - 1) / num_bins;
+        }
+
+        thrust::host_vector<int> expected(num_bins, 0);
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            if(h_data[i] < lower || !(h_data[i] < upper)) continue;
+
+            const unsigned long long offset = static_cast<unsigned long long>(h_data[i]) - static_cast<unsigned long long>(lower);
+
+            const size_t bin = std::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin() - 1;
+
+            ++expected[bin];
+        }
+
+        ASSERT_EQUAL(h_histogram, expected);
+        ASSERT_EQUAL(d_histogram, expected);
+    }
+};
+VariableUnitTest<TestHistogramEven, SignedIntegralTypes> TestHistogramEvenInstance;
+
+
+void TestHistogramEvenFloatingPoint(void)
+{
+    thrust::device_vector<float> data(7);
+
+    data[0] = -0.5f;
+    data[1] =  0.0f;
+    data[2] =  0.25f;
+    data[3] =  0.999f;
+    data[4] =  1.0f;
+    data[5] = std::numeric_limits<float>::quiet_NaN();
+    data[6] =  0.5f;
+
+    thrust::device_vector<float> histogram(4);
+
+    thrust::histogram_even(data.begin(), data.end(), histogram.begin(), 4, 0.0f, 1.0f);
+
+    // -0.5, 1.0 and NaN are not counted
+    ASSERT_EQUAL(histogram[0], 1.0f);
+    ASSERT_EQUAL(histogram[1], 1.0f);
+    ASSERT_EQUAL(histogram[2], 1.0f);
+    ASSERT_EQUAL(histogram[3], 1.0f);
+}
+DECLARE_UNITTEST(TestHistogramEvenFloatingPoint);
+
+
+template <typename T>
+struct TestHistogramRange
+{
+    void operator()(const size_t n)
+    {
+        thrust::host_vector<T>   h_data = unittest::random_integers<T>(n);
+        thrust::device_vector<T> d_data = h_data;
+
+        thrust::host_vector<T> h_levels = unittest::random_integers<T>(33);
+        thrust::sort(h_levels.begin(), h_levels.end());
+
+        thrust::device_vector<T> d_levels = h_levels;
+
+        thrust::host_vector<unsigned int>   h_histogram(32);
+        thrust::device_vector<unsigned int> d_histogram(32);
+
+        thrust::histogram_range(h_data.begin(), h_data.end(), h_levels.begin(), h_levels.end(), h_histogram.begin());
+        thrust::histogram_range(d_data.begin(), d_data.end(), d_levels.begin(), d_levels.end(), d_histogram.begin());
+
+        thrust::host_vector<unsigned int> expected(32, 0);
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            const size_t bin = std::upper_bound(h_levels.begin(), h_levels.end(), h_data[i]) - h_levels.begin();
+
+            // repeated levels delimit empty bins
+            if(0 < bin && bin < h_levels.size()) ++expected[bin - 1];
+        }
+
+        ASSERT_EQUAL(h_histogram, expected);
+        ASSERT_EQUAL(d_histogram, expected);
+    }
+};
+VariableUnitTest<TestHistogramRange, IntegralTypes> TestHistogramRangeInstance;
+
+
+void TestHistogramEvenManyBins(void)
+{
+    // enough bins for the bins of the tiles to be summed in several blocks,
+    // and enough samples for several tiles
+    const int n        = 1 << 20;
+    const int num_bins = 1 << 14;
+
+    thrust::device_vector<int> data(n);
+    thrust::sequence(data.begin(), data.end(), -n / 8);
+
+    thrust::device_vector<int> histogram(num_bins);
+
+    thrust::histogram_even(data.begin(), data.end(), histogram.begin(), num_bins, 0, n / 2);
+
+    thrust::host_vector<int> h_histogram = histogram;
+
+    for(int i = 0; i < num_bins; ++i)
+    {
+        ASSERT_EQUAL(h_histogram[i], n / 2 / num_bins);
+    }
+}
+DECLARE_UNITTEST(TestHistogramEvenManyBins);
+
@@ -1,6 +1,7 @@
 #include <unittest/unittest.h>
 #include <thrust/extrema.h>
 #include <thrust/iterator/retag.h>
+#include <limits>
 
 template <class Vector>
 void TestMinMaxElementSimple(void)
@@ -73,6 +74,107 @@ void TestMinMaxElement(const size_t n)
 DECLARE_VARIABLE_UNITTEST(TestMinMaxElement);
 
 
+
+template<typename T>
+struct less_mod_3
+{
+    __host__ __device__
+    bool operator()(const T& lhs, const T& rhs) const
+    {
+        return (static_cast<unsigned int>(lhs) % 3u) < (static_cast<unsigned int>(rhs) % 3u);
+    }
+};
+
+template<typename T>
+void TestMinMaxElementFirstOfEquivalent(const size_t n)
+{
+    // few distinct values, so that equivalent extrema appear in many places
+    thrust::host_vector<unsigned int> h_keys = unittest::random_integers<unsigned int>(n);
+    thrust::host_vector<T> h_data(n);
+
+    for(size_t i = 0; i < n; i++)
+        h_data[i] = static_cast<T>(h_keys[i] % 5u);
+
+    thrust::device_vector<T> d_data = h_data;
+
+    typedef typename thrust::host_vector<T>::iterator   HostIterator;
+    typedef typename thrust::device_vector<T>::iterator DeviceIterator;
+
+    thrust::pair<HostIterator,HostIterator>     h_result;
+    thrust::pair<DeviceIterator,DeviceIterator> d_result;
+
+    h_result = thrust::minmax_element(h_data.begin(), h_data.end());
+    d_result = thrust::minmax_element(d_data.begin(), d_data.end());
+
+    ASSERT_EQUAL(h_result.first  - h_data.begin(), d_result.first  - d_data.begin());
+    ASSERT_EQUAL(h_result.second - h_data.begin(), d_result.second - d_data.begin());
+
+    h_result = thrust::minmax_element(h_data.begin(), h_data.end(), thrust::greater<T>());
+    d_result = thrust::minmax_element(d_data.begin(), d_data.end(), thrust::greater<T>());
+
+    ASSERT_EQUAL(h_result.first  - h_data.begin(), d_result.first  - d_data.begin());
+    ASSERT_EQUAL(h_result.second - h_data.begin(), d_result.second - d_data.begin());
+
+    h_result = thrust::minmax_element(h_data.begin(), h_data.end(), less_mod_3<T>());
+    d_result = thrust::minmax_element(d_data.begin(), d_data.end(), less_mod_3<T>());
+
+    ASSERT_EQUAL(h_result.first  - h_data.begin(), d_result.first  - d_data.begin());
+    ASSERT_EQUAL(h_result.second - h_data.begin(), d_result.second - d_data.begin());
+
+    ASSERT_EQUAL(thrust::min_element(h_data.begin(), h_data.end()) - h_data.begin(),
+                 thrust::min_element(d_data.begin(), d_data.end()) - d_data.begin());
+    ASSERT_EQUAL(thrust::max_element(h_data.begin(), h_data.end()) - h_data.begin(),
+                 thrust::max_element(d_data.begin(), d_data.end()) - d_data.begin());
+}
+DECLARE_VARIABLE_UNITTEST(TestMinMaxElementFirstOfEquivalent);
+
+
+template<typename Vector>
+void TestMinMaxElementWithNaN(void)
+{
+    typedef typename Vector::value_type T;
+    typedef typename Vector::iterator   Iterator;
+
+    const size_t n = 100000;
+
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+
+    Vector data(n, T(0));
+    data[7]     = nan;
+    data[70000] = T(-2);
+    data[90000] = T(-2);
+    data[50000] = nan;
+    data[80000] = T(3);
+
+    // NaNs are never less or greater than the current extremum
+    thrust::pair<Iterator,Iterator> result = thrust::minmax_element(data.begin(), data.end());
+    ASSERT_EQUAL(result.first  - data.begin(), 70000);
+    ASSERT_EQUAL(result.second - data.begin(), 80000);
+    ASSERT_EQUAL(thrust::min_element(data.begin(), data.end()) - data.begin(), 70000);
+    ASSERT_EQUAL(thrust::max_element(data.begin(), data.end()) - data.begin(), 80000);
+
+    // but a leading NaN is never replaced
+    data[0] = nan;
+    result = thrust::minmax_element(data.begin(), data.end());
+    ASSERT_EQUAL(result.first  - data.begin(), 0);
+    ASSERT_EQUAL(result.second - data.begin(), 0);
+    ASSERT_EQUAL(thrust::min_element(data.begin(), data.end()) - data.begin(), 0);
+    ASSERT_EQUAL(thrust::max_element(data.begin(), data.end()) - data.begin(), 0);
+}
+void TestMinMaxElementWithNaNHost(void)
+{
+    TestMinMaxElementWithNaN< thrust::host_vector<float> >();
+    TestMinMaxElementWithNaN< thrust::host_vector<double> >();
+}
+DECLARE_UNITTEST(TestMinMaxElementWithNaNHost);
+
+void TestMinMaxElementWithNaNDevice(void)
+{
+    TestMinMaxElementWithNaN< thrust::device_vector<float> >();
+    TestMinMaxElementWithNaN< thrust::device_vector<double> >();
+}
+DECLARE_UNITTEST(TestMinMaxElementWithNaNDevice);
+
 template<typename ForwardIterator>
 thrust::pair<ForwardIterator,ForwardIterator> minmax_element(my_system &system, ForwardIterator first, ForwardIterator)
 {
@@ -74,3 +74,27 @@ void TestMismatchDispatchImplicit()
 }
 DECLARE_UNITTEST(TestMismatchDispatchImplicit);
 
+
+template <class Vector>
+void TestMismatchLarge(void)
+{
+    typedef typename Vector::value_type T;
+    typedef typename Vector::iterator   Iterator;
+
+    const long n = (1 << 20) + 7;
+
+    Vector a(n, T(0));
+    Vector b(n, T(0));
+
+    ASSERT_EQUAL(thrust::mismatch(a.begin(), a.end(), b.begin()).first - a.begin(), n);
+
+    b[n - 1]  = T(1);
+    b[600000] = T(1);
+
+    thrust::pair<Iterator,Iterator> result = thrust::mismatch(a.begin(), a.end(), b.begin());
+
+    ASSERT_EQUAL(result.first  - a.begin(), 600000);
+    ASSERT_EQUAL(result.second - b.begin(), 600000);
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestMismatchLarge);
+
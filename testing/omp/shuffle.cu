@@ -0,0 +1,158 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+#include <thrust/functional.h>
+#include <thrust/random.h>
+#include <thrust/sequence.h>
+#include <thrust/shuffle.h>
+#include <thrust/sort.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/transform_output_iterator.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/omp/detail/shuffle.h>
+#include <thrust/system/omp/detail/index_parallel_for.h>
+#include <map>
+
+
+void TestOmpShuffleLarge(void)
+{
+  typedef int T;
+  size_t m = (1 << 19) + 12345;
+  thrust::host_vector<T> sequence(m);
+  thrust::sequence(sequence.begin(), sequence.end(), T(0));
+
+  thrust::host_vector<T> shuffled(sequence);
+  thrust::default_random_engine g(7);
+  thrust::shuffle(thrust::omp::par, shuffled.begin(), shuffled.end(), g);
+
+  thrust::host_vector<T> shuffled_copy(m);
+  g.seed(7);
+  thrust::shuffle_copy(thrust::omp::par, sequence.begin(), sequence.end(), shuffled_copy.begin(), g);
+  ASSERT_EQUAL(shuffled_copy, shuffled);
+
+  ASSERT_EQUAL(thrust::is_sorted(shuffled.begin(), shuffled.end()), false);
+  thrust::sort(shuffled.begin(), shuffled.end());
+  ASSERT_EQUAL(shuffled, sequence);
+}
+DECLARE_UNITTEST(TestOmpShuffleLarge);
+
+
+void TestOmpShuffleCopyWriteOnlyOutput(void)
+{
+  typedef int T;
+  size_t m = 100000;
+  thrust::host_vector<T> sequence(m);
+  thrust::sequence(sequence.begin(), sequence.end(), T(0));
+
+  thrust::host_vector<T> shuffled(sequence);
+  thrust::default_random_engine g1(13);
+  thrust::shuffle(thrust::omp::par, shuffled.begin(), shuffled.end(), g1);
+
+  thrust::host_vector<T> transformed(m);
+  thrust::default_random_engine g2(13);
+  thrust::shuffle_copy(thrust::omp::par, sequence.begin(), sequence.end(),
+                       thrust::make_transform_output_iterator(transformed.begin(), thrust::identity<T>()), g2);
+  ASSERT_EQUAL(transformed, shuffled);
+
+  // a write-only output consumes the engine as shuffle does
+  thrust::default_random_engine g3(13);
+  thrust::shuffle_copy(thrust::omp::par, sequence.begin(), sequence.end(), thrust::make_discard_iterator(), g3);
+  ASSERT_EQUAL(g3(), g1());
+}
+DECLARE_UNITTEST(TestOmpShuffleCopyWriteOnlyOutput);
+
+
+template<typename Vector>
+void bucket_shuffle(Vector &v, thrust::default_random_engine &g, size_t bucket_size)
+{
+  thrust::system::omp::tag omp_tag;
+
+  thrust::system::detail::internal::bucket_shuffle(omp_tag,
+                                                   thrust::system::omp::detail::index_parallel_for(),
+                                                   v.begin(), v.end(), g, bucket_size);
+}
+
+
+// Shuffle with tiny buckets so that many buckets and tiles are used and the
+// last bucket is smaller than the others. Individual keys should still be
+// permuted to output locations with uniform probability. Perform chi-squared
+// test with confidence 99.9%.
+void TestOmpShuffleKeyPositionManyBuckets(void)
+{
+  typedef int T;
+  size_t m = 21;
+  size_t num_samples = 1000;
+  thrust::host_vector<size_t> index_sum(m, 0);
+
+  for (size_t i = 0; i < num_samples; i++) {
+    thrust::host_vector<T> shuffled(m);
+    thrust::sequence(shuffled.begin(), shuffled.end(), T(0));
+    thrust::default_random_engine g(i);
+    bucket_shuffle(shuffled, g, 4);
+
+    for (size_t j = 0; j < m; j++) {
+      index_sum[shuffled[j]] += j;
+    }
+  }
+
+  double expected_average_position = static_cast<double>(m - 1) / 2;
+  double chi_squared = 0.0;
+  for (size_t j = 0; j < m; j++) {
+    double average_position = static_cast<double>(index_sum[j]) / num_samples;
+    chi_squared += std::pow(expected_average_position - average_position, 2) /
+                   expected_average_position;
+  }
+  // Tabulated chi-squared critical value for m-1=20 degrees of freedom
+  // and 99.9% confidence
+  double confidence_threshold = 45.31;
+  ASSERT_LESS(chi_squared, confidence_threshold);
+}
+DECLARE_UNITTEST(TestOmpShuffleKeyPositionManyBuckets);
+
+
+struct vector_compare {
+  template <typename VectorT>
+  bool operator()(const VectorT& a, const VectorT& b) const {
+    for (size_t i = 0; i < a.size(); i++) {
+      if (a[i] < b[i]) return true;
+      if (a[i] > b[i]) return false;
+    }
+    return false;
+  }
+};
+
+
+// Brute force check permutations are uniformly distributed when the input is
+// spread over three buckets. Uses a chi-squared test indicating 99%
+// confidence the output is uniformly random
+void TestOmpShuffleUniformPermutationManyBuckets(void)
+{
+  typedef int T;
+  size_t m = 5;
+  size_t num_samples = 1000;
+  size_t total_permutations = 1 * 2 * 3 * 4 * 5;
+  std::map<thrust::host_vector<T>, size_t, vector_compare> permutation_counts;
+  thrust::host_vector<T> sequence(m);
+  thrust::sequence(sequence.begin(), sequence.end(), T(0));
+  thrust::default_random_engine g(17);
+  for (size_t i = 0; i < num_samples; i++) {
+    bucket_shuffle(sequence, g, 2);
+    permutation_counts[sequence]++;
+  }
+
+  ASSERT_EQUAL(permutation_counts.size(), total_permutations);
+
+  double chi_squared = 0.0;
+  double expected_count = static_cast<double>(num_samples) / total_permutations;
+  for (auto kv : permutation_counts) {
+    chi_squared += std::pow(expected_count - kv.second, 2) / expected_count;
+  }
+  // Tabulated chi-squared critical value for 119 degrees of freedom (5! - 1)
+  // and 99% confidence
+  double confidence_threshold = 157.8;
+  ASSERT_LESS(chi_squared, confidence_threshold);
+}
+DECLARE_UNITTEST(TestOmpShuffleUniformPermutationManyBuckets);
+#endif
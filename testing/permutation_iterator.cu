@@ -1,10 +1,14 @@
 #include <unittest/unittest.h>
 #include <thrust/iterator/permutation_iterator.h>
 #include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
 
 #include <thrust/reduce.h>
 #include <thrust/transform_reduce.h>
 #include <thrust/sequence.h>
+#include <thrust/transform.h>
+#include <thrust/functional.h>
+#include <thrust/sort.h>
 
 template <class Vector>
 void TestPermutationIteratorSimple(void)
@@ -314,3 +318,107 @@ void TestPermutationIteratorWithCountingIterator(void)
 }
 DECLARE_INTEGRAL_VECTOR_UNITTEST(TestPermutationIteratorWithCountingIterator);
 
+
+template <typename T>
+void TestPermutationIteratorTransformRandomMap(const size_t n)
+{
+    thrust::host_vector<T>   h_source = unittest::random_samples<T>(n);
+    thrust::device_vector<T> d_source = h_source;
+
+    // a random map over the whole source, so that the elements are visited
+    // in an unpredictable order
+    thrust::host_vector<unsigned int> h_map = unittest::random_integers<unsigned int>(n);
+
+    for(size_t i = 0; i < n; i++)
+        h_map[i] = h_map[i] % n;
+
+    thrust::device_vector<unsigned int> d_map = h_map;
+
+    thrust::host_vector<T> expected(n);
+
+    for(size_t i = 0; i < n; i++)
+        expected[i] = static_cast<T>(-h_source[h_map[i]]);
+
+    // transform through a permuted input
+    {
+        thrust::host_vector<T>   h_output(n);
+        thrust::device_vector<T> d_output(n);
+
+        thrust::transform(thrust::make_permutation_iterator(h_source.begin(), h_map.begin()),
+                          thrust::make_permutation_iterator(h_source.begin(), h_map.end()),
+                          h_output.begin(),
+                          thrust::negate<T>());
+        thrust::transform(thrust::make_permutation_iterator(d_source.begin(), d_map.begin()),
+                          thrust::make_permutation_iterator(d_source.begin(), d_map.end()),
+                          d_output.begin(),
+                          thrust::negate<T>());
+
+        ASSERT_EQUAL(h_output, expected);
+        ASSERT_EQUAL(d_output, expected);
+    }
+
+    // transform through a permuted output, using a random permutation as
+    // the map so that every position is written exactly once
+    {
+        thrust::host_vector<unsigned int> h_keys = unittest::random_integers<unsigned int>(n);
+        thrust::host_vector<unsigned int> h_perm(n);
+        thrust::sequence(h_perm.begin(), h_perm.end());
+        thrust::sort_by_key(h_keys.begin(), h_keys.end(), h_perm.begin());
+
+        thrust::host_vector<T> h_permuted(n);
+
+        thrust::device_vector<unsigned int> d_perm = h_perm;
+
+        thrust::host_vector<T>   h_output(n);
+        thrust::device_vector<T> d_output(n);
+
+        thrust::transform(h_source.begin(), h_source.end(),
+                          thrust::make_permutation_iterator(h_output.begin(), h_perm.begin()),
+                          thrust::negate<T>());
+        thrust::transform(d_source.begin(), d_source.end(),
+                          thrust::make_permutation_iterator(d_output.begin(), d_perm.begin()),
+                          thrust::negate<T>());
+
+        for(size_t i = 0; i < n; i++)
+            h_permuted[h_perm[i]] = static_cast<T>(-h_source[i]);
+
+        ASSERT_EQUAL(h_output, h_permuted);
+        ASSERT_EQUAL(d_output, h_permuted);
+    }
+}
+DECLARE_VARIABLE_UNITTEST(TestPermutationIteratorTransformRandomMap);
+
+
+// hands out consecutive indices, so it must be invoked exactly once per element
+struct next_index
+{
+    size_t *counter;
+
+    __host__
+    size_t operator()(int) const
+    {
+        return (*counter)++;
+    }
+};
+
+void TestPermutationIteratorTransformStatefulMap(void)
+{
+    const size_t n = 1000;
+
+    thrust::host_vector<int> source(n);
+    thrust::sequence(source.begin(), source.end());
+
+    thrust::host_vector<int> output(n, -1);
+
+    size_t counter = 0;
+    next_index f = {&counter};
+
+    thrust::transform(source.begin(), source.end(),
+                      thrust::make_permutation_iterator(output.begin(),
+                                                        thrust::make_transform_iterator(source.begin(), f)),
+                      thrust::identity<int>());
+
+    ASSERT_EQUAL(counter, n);
+    ASSERT_EQUAL(output, source);
+}
+DECLARE_UNITTEST(TestPermutationIteratorTransformStatefulMap);
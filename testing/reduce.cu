@@ -148,6 +148,40 @@ struct TestReduceWithOperator
 VariableUnitTest<TestReduceWithOperator, UnsignedIntegralTypes> TestReduceWithOperatorInstance;
 
 
+template <typename T>
+struct TestReduceWithVectorizableOperators
+{
+    void operator()(const size_t n)
+    {
+        thrust::host_vector<T>   h_data = unittest::random_samples<T>(n);
+        thrust::device_vector<T> d_data = h_data;
+
+        T init = 13;
+
+        T expected_max = init;
+        T expected_min = init;
+        T expected_sum = init;
+
+        for(size_t i = 0; i < n; i++)
+        {
+            expected_max = expected_max < h_data[i] ? h_data[i] : expected_max;
+            expected_min = h_data[i] < expected_min ? h_data[i] : expected_min;
+            expected_sum = expected_sum + h_data[i];
+        }
+
+        ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), init, thrust::maximum<T>()), expected_max);
+        ASSERT_EQUAL(thrust::reduce(d_data.begin(), d_data.end(), init, thrust::maximum<T>()), expected_max);
+        ASSERT_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), init, thrust::minimum<T>()), expected_min);
+        ASSERT_EQUAL(thrust::reduce(d_data.begin(), d_data.end(), init, thrust::minimum<T>()), expected_min);
+
+        // the sum may be accumulated in any order
+        ASSERT_ALMOST_EQUAL(thrust::reduce(h_data.begin(), h_data.end(), init, thrust::plus<T>()), expected_sum);
+        ASSERT_ALMOST_EQUAL(thrust::reduce(d_data.begin(), d_data.end(), init, thrust::plus<T>()), expected_sum);
+    }
+};
+VariableUnitTest<TestReduceWithVectorizableOperators, FloatingPointTypes> TestReduceWithVectorizableOperatorsInstance;
+
+
 template <typename T>
 struct plus_mod3
 {
@@ -3,6 +3,11 @@
 #include <thrust/unique.h>
 #include <thrust/iterator/discard_iterator.h>
 #include <thrust/iterator/retag.h>
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/functional.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
 
 template<typename T>
 struct is_equal_div_10_reduce
@@ -262,3 +267,179 @@ void TestReduceByKeyDispatchImplicit()
 }
 DECLARE_UNITTEST(TestReduceByKeyDispatchImplicit);
 
+
+
+template<typename Vector>
+void TestReduceByKeyUnsortedSimple(void)
+{
+    typedef typename Vector::value_type T;
+
+    Vector keys(7), values(7);
+
+    keys[0] = 1;  values[0] = 9;
+    keys[1] = 3;  values[1] = 8;
+    keys[2] = 3;  values[2] = 7;
+    keys[3] = 2;  values[3] = 6;
+    keys[4] = 3;  values[4] = 5;
+    keys[5] = 2;  values[5] = 4;
+    keys[6] = 1;  values[6] = 3;
+
+    Vector output_keys(7), output_values(7);
+
+    thrust::pair<typename Vector::iterator, typename Vector::iterator> new_last =
+      thrust::reduce_by_key_unsorted(keys.begin(), keys.end(), values.begin(), output_keys.begin(), output_values.begin());
+
+    ASSERT_EQUAL(new_last.first  - output_keys.begin(),   3);
+    ASSERT_EQUAL(new_last.second - output_values.begin(), 3);
+
+    // the order of the keys is unspecified
+    output_keys.resize(3);
+    output_values.resize(3);
+
+    thrust::sort_by_key(output_keys.begin(), output_keys.end(), output_values.begin());
+
+    ASSERT_EQUAL(output_keys[0], T(1));
+    ASSERT_EQUAL(output_keys[1], T(2));
+    ASSERT_EQUAL(output_keys[2], T(3));
+
+    ASSERT_EQUAL(output_values[0], T(12));
+    ASSERT_EQUAL(output_values[1], T(10));
+    ASSERT_EQUAL(output_values[2], T(20));
+
+    // the values of every key are reduced in input order
+    new_last = thrust::reduce_by_key_unsorted(keys.begin(), keys.end(), values.begin(), output_keys.begin(), output_values.begin(), thrust::project2nd<T,T>());
+
+    thrust::sort_by_key(output_keys.begin(), output_keys.end(), output_values.begin());
+
+    ASSERT_EQUAL(output_values[0], T(3));
+    ASSERT_EQUAL(output_values[1], T(4));
+    ASSERT_EQUAL(output_values[2], T(5));
+}
+DECLARE_INTEGRAL_VECTOR_UNITTEST(TestReduceByKeyUnsortedSimple);
+
+
+template<typename K>
+struct TestReduceByKeyUnsorted
+{
+    void operator()(const size_t n)
+    {
+        typedef unsigned int V; // ValueType
+
+        // few distinct keys, in no particular order
+        thrust::host_vector<K> h_keys = unittest::random_integers<K>(n);
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            h_keys[i] = K(h_keys[i] % K(100));
+        }
+
+        thrust::host_vector<V>   h_vals = unittest::random_integers<V>(n);
+        thrust::device_vector<K> d_keys = h_keys;
+        thrust::device_vector<V> d_vals = h_vals;
+
+        thrust::host_vector<K>   h_keys_output(n);
+        thrust::host_vector<V>   h_vals_output(n);
+        thrust::device_vector<K> d_keys_output(n);
+        thrust::device_vector<V> d_vals_output(n);
+
+        size_t h_size = thrust::reduce_by_key_unsorted(h_keys.begin(), h_keys.end(), h_vals.begin(), h_keys_output.begin(), h_vals_output.begin()).first - h_keys_output.begin();
+        size_t d_size = thrust::reduce_by_key_unsorted(d_keys.begin(), d_keys.end(), d_vals.begin(), d_keys_output.begin(), d_vals_output.begin()).first - d_keys_output.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+
+        h_keys_output.resize(h_size);
+        h_vals_output.resize(h_size);
+        d_keys_output.resize(d_size);
+        d_vals_output.resize(d_size);
+
+        thrust::sort_by_key(h_keys_output.begin(), h_keys_output.end(), h_vals_output.begin());
+        thrust::sort_by_key(d_keys_output.begin(), d_keys_output.end(), d_vals_output.begin());
+
+        ASSERT_EQUAL(h_keys_output, d_keys_output);
+        ASSERT_EQUAL(h_vals_output, d_vals_output);
+    }
+};
+VariableUnitTest<TestReduceByKeyUnsorted, IntegralTypes> TestReduceByKeyUnsortedInstance;
+
+
+void TestReduceByKeyUnsortedManyKeys(void)
+{
+    // too many distinct keys to aggregate them in tables, and one key which
+    // appears in every part of the input
+    const int n = 1 << 18;
+
+    thrust::host_vector<int> h_keys(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        h_keys[i] = (i % 3 == 0) ? -1 : (i * 7919) % n;
+    }
+
+    thrust::device_vector<int> d_keys = h_keys;
+    thrust::device_vector<int> d_vals(n, 1);
+
+    thrust::device_vector<int> d_keys_output(n);
+    thrust::device_vector<int> d_vals_output(n);
+
+    thrust::pair<thrust::device_vector<int>::iterator, thrust::device_vector<int>::iterator> new_last =
+      thrust::reduce_by_key_unsorted(d_keys.begin(), d_keys.end(), d_vals.begin(), d_keys_output.begin(), d_vals_output.begin());
+
+    thrust::host_vector<int> h_keys_output(d_keys_output.begin(), new_last.first);
+    thrust::host_vector<int> h_vals_output(d_vals_output.begin(), new_last.second);
+
+    thrust::sort_by_key(h_keys_output.begin(), h_keys_output.end(), h_vals_output.begin());
+
+    thrust::host_vector<int> h_vals(n, 1);
+    thrust::sort(h_keys.begin(), h_keys.end());
+
+    thrust::host_vector<int> h_keys_expected(n);
+    thrust::host_vector<int> h_vals_expected(n);
+
+    size_t expected_size = thrust::reduce_by_key(h_keys.begin(), h_keys.end(), h_vals.begin(), h_keys_expected.begin(), h_vals_expected.begin()).first - h_keys_expected.begin();
+
+    h_keys_expected.resize(expected_size);
+    h_vals_expected.resize(expected_size);
+
+    ASSERT_EQUAL(h_keys_output, h_keys_expected);
+    ASSERT_EQUAL(h_vals_output, h_vals_expected);
+}
+DECLARE_UNITTEST(TestReduceByKeyUnsortedManyKeys);
+
+
+void TestReduceByKeyUnsortedManyTiles(void)
+{
+    // keys are output in the order of their first occurrence by the host
+    // parallel systems, but that is unspecified, so sort the results
+    const int n = 1 << 20;
+
+    thrust::device_vector<long long> d_keys(n);
+    thrust::sequence(d_keys.begin(), d_keys.end());
+    thrust::transform(d_keys.begin(), d_keys.end(), thrust::make_constant_iterator<long long>(1000), d_keys.begin(), thrust::modulus<long long>());
+
+    thrust::device_vector<long long> d_keys_output(n);
+    thrust::device_vector<int>       d_vals_output(n);
+
+    thrust::pair<thrust::device_vector<long long>::iterator, thrust::device_vector<int>::iterator> new_last =
+      thrust::reduce_by_key_unsorted(d_keys.begin(), d_keys.end(), thrust::make_constant_iterator<int>(1), d_keys_output.begin(), d_vals_output.begin());
+
+    ASSERT_EQUAL(new_last.first - d_keys_output.begin(), 1000);
+
+    d_keys_output.resize(1000);
+    d_vals_output.resize(1000);
+
+    thrust::sort_by_key(d_keys_output.begin(), d_keys_output.end(), d_vals_output.begin());
+
+    thrust::host_vector<long long> h_keys_expected(1000);
+    thrust::sequence(h_keys_expected.begin(), h_keys_expected.end());
+
+    thrust::host_vector<int> h_vals_expected(1000, n / 1000);
+
+    for(int i = 0; i < n % 1000; ++i)
+    {
+        ++h_vals_expected[i];
+    }
+
+    ASSERT_EQUAL(d_keys_output, h_keys_expected);
+    ASSERT_EQUAL(d_vals_output, h_vals_expected);
+}
+DECLARE_UNITTEST(TestReduceByKeyUnsortedManyTiles);
@@ -578,6 +578,47 @@ void TestScanByKeyLargeInput()
 DECLARE_UNITTEST(TestScanByKeyLargeInput);
 
 
+void TestScanByKeyLongSegments()
+{
+    const int N = (1 << 20) + 7;
+
+    // small values, so that the sums do not overflow
+    thrust::host_vector<int> h_vals = unittest::random_integers<int>(N);
+    for (int i = 0; i < N; i++)
+        h_vals[i] %= 1000;
+    thrust::device_vector<int> d_vals = h_vals;
+
+    thrust::host_vector<int>   h_output(N);
+    thrust::device_vector<int> d_output(N);
+
+    // segments shorter and longer than the tiles of the parallel scans,
+    // which may begin anywhere in a tile
+    const int segment_sizes[] = {1, 4095, 4096, 4097, 100003, N};
+
+    for (size_t s = 0; s < sizeof(segment_sizes) / sizeof(int); s++)
+    {
+        thrust::host_vector<int> h_keys(N);
+        for (int i = 0; i < N; i++)
+            h_keys[i] = i / segment_sizes[s];
+        thrust::device_vector<int> d_keys = h_keys;
+
+        thrust::inclusive_scan_by_key(h_keys.begin(), h_keys.end(), h_vals.begin(), h_output.begin());
+        thrust::inclusive_scan_by_key(d_keys.begin(), d_keys.end(), d_vals.begin(), d_output.begin());
+        ASSERT_EQUAL(d_output, h_output);
+
+        thrust::exclusive_scan_by_key(h_keys.begin(), h_keys.end(), h_vals.begin(), h_output.begin(), 13);
+        thrust::exclusive_scan_by_key(d_keys.begin(), d_keys.end(), d_vals.begin(), d_output.begin(), 13);
+        ASSERT_EQUAL(d_output, h_output);
+
+        // in place
+        thrust::device_vector<int> d_inout = d_vals;
+        thrust::exclusive_scan_by_key(d_keys.begin(), d_keys.end(), d_inout.begin(), d_inout.begin(), 13);
+        ASSERT_EQUAL(d_inout, h_output);
+    }
+}
+DECLARE_UNITTEST(TestScanByKeyLongSegments);
+
+
 template <typename T, unsigned int N>
 void _TestScanByKeyWithLargeTypes(void)
 {
@@ -46,7 +46,7 @@ DECLARE_VECTOR_UNITTEST(TestShuffleCopySimple);
 template <typename T>
 void TestHostDeviceIdentical(size_t m) {
   thrust::host_vector<T> host_result(m);
-  thrust::host_vector<T> device_result(m);
+  thrust::device_vector<T> device_result(m);
   thrust::sequence(host_result.begin(), host_result.end(), 0llu);
   thrust::sequence(device_result.begin(), device_result.end(), 0llu);
 
@@ -56,7 +56,19 @@ void TestHostDeviceIdentical(size_t m) {
   thrust::shuffle(host_result.begin(), host_result.end(), host_g);
   thrust::shuffle(device_result.begin(), device_result.end(), device_g);
 
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || \
+    THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+  // the host parallel systems use a different algorithm, so only check
+  // that the device permutation is reproducible
+  thrust::device_vector<T> device_result2(m);
+  thrust::sequence(device_result2.begin(), device_result2.end(), 0llu);
+  device_g.seed(183);
+  thrust::shuffle(device_result2.begin(), device_result2.end(), device_g);
+
+  ASSERT_EQUAL(device_result2, device_result);
+#else
   ASSERT_EQUAL(device_result, host_result);
+#endif
 }
 DECLARE_VARIABLE_UNITTEST(TestHostDeviceIdentical);
 
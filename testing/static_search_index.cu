@@ -0,0 +1,237 @@
+#include <unittest/unittest.h>
+#include <thrust/static_search_index.h>
+#include <thrust/binary_search.h>
+#include <thrust/execution_policy.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+
+#include <thrust/detail/allocator/allocator_traits.h>
+
+#include <memory>
+
+
+// convert xxx_vector<T1> to xxx_vector<T2>
+template <class ExampleVector, typename NewType>
+struct vector_like
+{
+    typedef typename ExampleVector::allocator_type alloc;
+    typedef typename thrust::detail::allocator_traits<alloc> alloc_traits;
+    typedef typename alloc_traits::template rebind_alloc<NewType> new_alloc;
+    typedef thrust::detail::vector_base<NewType, new_alloc> type;
+};
+
+
+template <class Vector>
+void TestStaticSearchIndexSimple(void)
+{
+    typedef typename Vector::value_type T;
+    typedef thrust::static_search_index<T, thrust::less<T>, typename Vector::allocator_type> Index;
+    typedef typename Index::size_type size_type;
+    typedef typename vector_like<Vector, size_type>::type SizeVector;
+    typedef thrust::pair<size_type,size_type> Pair;
+    typedef typename vector_like<Vector, Pair>::type PairVector;
+
+    Vector vec(5);
+
+    vec[0] = 0;
+    vec[1] = 2;
+    vec[2] = 5;
+    vec[3] = 7;
+    vec[4] = 8;
+
+    Index index(vec.begin(), vec.end());
+
+    ASSERT_EQUAL(index.size(), size_type(5));
+    ASSERT_EQUAL(index.empty(), false);
+
+    Vector input(10);
+    thrust::sequence(input.begin(), input.end());
+
+    SizeVector output(10);
+
+    typename SizeVector::iterator output_end = index.lower_bound(input.begin(), input.end(), output.begin());
+
+    ASSERT_EQUAL(output_end - output.begin(), 10);
+
+    ASSERT_EQUAL(output[0], size_type(0));
+    ASSERT_EQUAL(output[1], size_type(1));
+    ASSERT_EQUAL(output[2], size_type(1));
+    ASSERT_EQUAL(output[3], size_type(2));
+    ASSERT_EQUAL(output[4], size_type(2));
+    ASSERT_EQUAL(output[5], size_type(2));
+    ASSERT_EQUAL(output[6], size_type(3));
+    ASSERT_EQUAL(output[7], size_type(3));
+    ASSERT_EQUAL(output[8], size_type(4));
+    ASSERT_EQUAL(output[9], size_type(5));
+
+    output_end = index.upper_bound(input.begin(), input.end(), output.begin());
+
+    ASSERT_EQUAL(output_end - output.begin(), 10);
+
+    ASSERT_EQUAL(output[0], size_type(1));
+    ASSERT_EQUAL(output[1], size_type(1));
+    ASSERT_EQUAL(output[2], size_type(2));
+    ASSERT_EQUAL(output[3], size_type(2));
+    ASSERT_EQUAL(output[4], size_type(2));
+    ASSERT_EQUAL(output[5], size_type(3));
+    ASSERT_EQUAL(output[6], size_type(3));
+    ASSERT_EQUAL(output[7], size_type(4));
+    ASSERT_EQUAL(output[8], size_type(5));
+    ASSERT_EQUAL(output[9], size_type(5));
+
+    PairVector ranges(10);
+
+    typename PairVector::iterator ranges_end = index.equal_range(input.begin(), input.end(), ranges.begin());
+
+    ASSERT_EQUAL(ranges_end - ranges.begin(), 10);
+
+    ASSERT_EQUAL_QUIET(Pair(ranges[0]), Pair(0, 1));
+    ASSERT_EQUAL_QUIET(Pair(ranges[1]), Pair(1, 1));
+    ASSERT_EQUAL_QUIET(Pair(ranges[2]), Pair(1, 2));
+    ASSERT_EQUAL_QUIET(Pair(ranges[5]), Pair(2, 3));
+    ASSERT_EQUAL_QUIET(Pair(ranges[8]), Pair(4, 5));
+    ASSERT_EQUAL_QUIET(Pair(ranges[9]), Pair(5, 5));
+}
+DECLARE_VECTOR_UNITTEST(TestStaticSearchIndexSimple);
+
+
+void TestStaticSearchIndexEmpty(void)
+{
+    thrust::static_search_index<int> index;
+
+    ASSERT_EQUAL(index.size(), 0lu);
+    ASSERT_EQUAL(index.empty(), true);
+
+    thrust::device_vector<int> input(3);
+    thrust::sequence(input.begin(), input.end());
+
+    thrust::device_vector<size_t> output(3, 7);
+
+    index.lower_bound(input.begin(), input.end(), output.begin());
+
+    ASSERT_EQUAL(output, thrust::device_vector<size_t>(3, 0));
+
+    index.upper_bound(input.begin(), input.end(), output.begin());
+
+    ASSERT_EQUAL(output, thrust::device_vector<size_t>(3, 0));
+}
+DECLARE_UNITTEST(TestStaticSearchIndexEmpty);
+
+
+// every shape of the tree, from a single node to several full levels
+void TestStaticSearchIndexAllSmallSizes(void)
+{
+    for(int n = 0; n < 140; ++n)
+    {
+        // every element is duplicated, and the queries fall on and between them
+        thrust::host_vector<int> table(n);
+
+        for(int i = 0; i < n; ++i)
+        {
+            table[i] = 2 * (i / 2);
+        }
+
+        thrust::host_vector<int> input(n + 3);
+        thrust::sequence(input.begin(), input.end(), -1);
+
+        thrust::static_search_index<int, thrust::less<int>, std::allocator<int> > index(thrust::host, table.begin(), table.end());
+
+        ASSERT_EQUAL(index.size(), size_t(n));
+
+        thrust::host_vector<size_t> expected(n + 3);
+        thrust::host_vector<size_t> result(n + 3);
+
+        thrust::lower_bound(table.begin(), table.end(), input.begin(), input.end(), expected.begin());
+        index.lower_bound(thrust::host, input.begin(), input.end(), result.begin());
+
+        ASSERT_EQUAL(result, expected);
+
+        thrust::upper_bound(table.begin(), table.end(), input.begin(), input.end(), expected.begin());
+        index.upper_bound(thrust::host, input.begin(), input.end(), result.begin());
+
+        ASSERT_EQUAL(result, expected);
+    }
+}
+DECLARE_UNITTEST(TestStaticSearchIndexAllSmallSizes);
+
+
+template <typename T>
+struct TestStaticSearchIndex
+{
+    void operator()(const size_t n)
+    {
+        typedef thrust::static_search_index<T> Index;
+
+        // few distinct keys, so that the table has long runs of duplicates
+        thrust::host_vector<T> h_table = unittest::random_integers<T>(n);
+
+        for(size_t i = 0; i < n; ++i)
+        {
+            h_table[i] = T(h_table[i] / T(64));
+        }
+
+        thrust::sort(h_table.begin(), h_table.end());
+
+        thrust::device_vector<T> d_table = h_table;
+
+        thrust::host_vector<T>   h_input = unittest::random_integers<T>(2 * n + 1);
+        thrust::device_vector<T> d_input = h_input;
+
+        Index index(d_table.begin(), d_table.end());
+
+        thrust::host_vector<size_t>   h_expected(2 * n + 1);
+        thrust::device_vector<size_t> d_result(2 * n + 1);
+
+        thrust::lower_bound(h_table.begin(), h_table.end(), h_input.begin(), h_input.end(), h_expected.begin());
+        index.lower_bound(d_input.begin(), d_input.end(), d_result.begin());
+
+        ASSERT_EQUAL(d_result, h_expected);
+
+        thrust::upper_bound(h_table.begin(), h_table.end(), h_input.begin(), h_input.end(), h_expected.begin());
+        index.upper_bound(thrust::device, d_input.begin(), d_input.end(), d_result.begin());
+
+        ASSERT_EQUAL(d_result, h_expected);
+    }
+};
+VariableUnitTest<TestStaticSearchIndex, SignedIntegralTypes> TestStaticSearchIndexInstance;
+
+
+void TestStaticSearchIndexDescending(void)
+{
+    typedef thrust::static_search_index<int, thrust::greater<int> > Index;
+
+    thrust::host_vector<int> h_table = unittest::random_integers<int>(1000);
+
+    for(size_t i = 0; i < h_table.size(); ++i)
+    {
+        h_table[i] %= 100;
+    }
+
+    thrust::sort(h_table.begin(), h_table.end(), thrust::greater<int>());
+
+    thrust::device_vector<int> d_table = h_table;
+
+    thrust::host_vector<int> h_input(250);
+    thrust::sequence(h_input.begin(), h_input.end(), -125);
+
+    thrust::device_vector<int> d_input = h_input;
+
+    Index index(thrust::device, d_table.begin(), d_table.end(), thrust::greater<int>());
+
+    thrust::host_vector<thrust::pair<size_t,size_t> >   h_expected(250);
+    thrust::device_vector<thrust::pair<size_t,size_t> > d_result(250);
+
+    for(size_t i = 0; i < h_input.size(); ++i)
+    {
+        thrust::pair<thrust::host_vector<int>::iterator, thrust::host_vector<int>::iterator> range =
+          thrust::equal_range(h_table.begin(), h_table.end(), h_input[i], thrust::greater<int>());
+
+        h_expected[i] = thrust::make_pair(size_t(range.first - h_table.begin()), size_t(range.second - h_table.begin()));
+    }
+
+    index.equal_range(thrust::device, d_input.begin(), d_input.end(), d_result.begin());
+
+    ASSERT_EQUAL_QUIET(d_result, h_expected);
+}
+DECLARE_UNITTEST(TestStaticSearchIndexDescending);
+
@@ -436,3 +436,93 @@ struct TestUniqueCopyByKeyToDiscardIterator
 };
 VariableUnitTest<TestUniqueCopyByKeyToDiscardIterator, IntegralTypes> TestUniqueCopyByKeyToDiscardIteratorInstance;
 
+
+
+template<typename K>
+struct TestUniqueByKeyLongRuns
+{
+    void operator()(const size_t n)
+    {
+        typedef unsigned int V; // ValueType
+
+        // runs of equal keys of every length, some longer than the tiles of
+        // the parallel implementations
+        thrust::host_vector<K> h_keys(n);
+
+        for(size_t i = 0, run = 1; i < n; run *= 3)
+        {
+            for(size_t j = 0; j < run && i < n; ++j, ++i)
+            {
+                h_keys[i] = K(run % 2);
+            }
+        }
+
+        thrust::host_vector<V>   h_vals = unittest::random_integers<V>(n);
+        thrust::device_vector<K> d_keys = h_keys;
+        thrust::device_vector<V> d_vals = h_vals;
+
+        thrust::host_vector<K>   h_keys_output(n);
+        thrust::host_vector<V>   h_vals_output(n);
+        thrust::device_vector<K> d_keys_output(n);
+        thrust::device_vector<V> d_vals_output(n);
+
+        size_t h_size = thrust::unique_by_key_copy(h_keys.begin(), h_keys.end(), h_vals.begin(), h_keys_output.begin(), h_vals_output.begin()).first - h_keys_output.begin();
+        size_t d_size = thrust::unique_by_key_copy(d_keys.begin(), d_keys.end(), d_vals.begin(), d_keys_output.begin(), d_vals_output.begin()).first - d_keys_output.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+        ASSERT_EQUAL(h_keys_output, d_keys_output);
+        ASSERT_EQUAL(h_vals_output, d_vals_output);
+
+        h_size = thrust::unique_by_key(h_keys.begin(), h_keys.end(), h_vals.begin()).first - h_keys.begin();
+        d_size = thrust::unique_by_key(d_keys.begin(), d_keys.end(), d_vals.begin()).first - d_keys.begin();
+
+        ASSERT_EQUAL(h_size, d_size);
+
+        h_keys.resize(h_size);
+        h_vals.resize(h_size);
+        d_keys.resize(d_size);
+        d_vals.resize(d_size);
+
+        ASSERT_EQUAL(h_keys, d_keys);
+        ASSERT_EQUAL(h_vals, d_vals);
+    }
+};
+VariableUnitTest<TestUniqueByKeyLongRuns, IntegralTypes> TestUniqueByKeyLongRunsInstance;
+
+
+void TestUniqueByKeyManyTiles(void)
+{
+    // every other key repeats, so that every tile both keeps and moves
+    // elements, and some tiles begin in the middle of a run
+    const int n = 1 << 20;
+
+    thrust::host_vector<int> h_keys(n);
+    thrust::host_vector<int> h_vals(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        h_keys[i] = (i / 4096) % 2 ? i / 3 : i;
+        h_vals[i] = i;
+    }
+
+    thrust::device_vector<int> d_keys = h_keys;
+    thrust::device_vector<int> d_vals = h_vals;
+
+    thrust::pair<thrust::host_vector<int>::iterator, thrust::host_vector<int>::iterator> h_last =
+      thrust::unique_by_key(h_keys.begin(), h_keys.end(), h_vals.begin());
+
+    thrust::pair<thrust::device_vector<int>::iterator, thrust::device_vector<int>::iterator> d_last =
+      thrust::unique_by_key(d_keys.begin(), d_keys.end(), d_vals.begin());
+
+    ASSERT_EQUAL(h_last.first - h_keys.begin(), d_last.first - d_keys.begin());
+    ASSERT_EQUAL(h_last.second - h_vals.begin(), d_last.second - d_vals.begin());
+
+    h_keys.erase(h_last.first, h_keys.end());
+    h_vals.erase(h_last.second, h_vals.end());
+    d_keys.erase(d_last.first, d_keys.end());
+    d_vals.erase(d_last.second, d_vals.end());
+
+    ASSERT_EQUAL(h_keys, d_keys);
+    ASSERT_EQUAL(h_vals, d_vals);
+}
+DECLARE_UNITTEST(TestUniqueByKeyManyTiles);
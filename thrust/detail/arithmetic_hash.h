@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file arithmetic_hash.h
+ *  \brief A hash of arithmetic values consistent with their operator==.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+
+#include <cstring>
+
+namespace thrust
+{
+namespace detail
+{
+namespace arithmetic_hash_detail
+{
+
+
+// the finalizer of MurmurHash3: every bit of x affects every bit of the
+// result, so tables may use the low bits of the hash as the slot
+__host__ __device__
+inline uint64_t mix(uint64_t x)
+{
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+
+  return x;
+}
+
+
+template<typename T>
+__host__ __device__
+uint64_t hash(T x, false_type)
+{
+  return mix(static_cast<uint64_t>(x));
+}
+
+
+// floating point values are hashed by their bits, but -0 == +0, so zeros
+// are normalized first
+template<typename T>
+__host__ __device__
+uint64_t hash(T x, true_type)
+{
+  if(x == T(0)) x = T(0);
+
+  uint64_t bits = 0;
+  std::memcpy(&bits, &x, sizeof(T));
+
+  return mix(bits);
+}
+
+
+} // end arithmetic_hash_detail
+
+
+// a hash consistent with operator== of an arithmetic type T
+template<typename T>
+struct arithmetic_hash
+{
+  __host__ __device__
+  uint64_t operator()(const T &x) const
+  {
+    return arithmetic_hash_detail::hash(x, is_floating_point<T>());
+  }
+};
+
+
+} // end namespace detail
+} // end namespace thrust
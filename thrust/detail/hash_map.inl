@@ -0,0 +1,749 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/hash_map.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/distance.h>
+#include <thrust/fill.h>
+#include <thrust/for_each.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace hash_map_detail
+{
+
+
+// bulk insertions fill the partitions of the slots in parallel
+const int max_partitions     = 256;
+const int min_partition_size = 1 << 12;
+
+// the keys of a bulk insertion are grouped by partition in tiles
+const int max_tiles     = 256;
+const int min_tile_size = 1 << 12;
+
+
+// the number of slots which holds n elements at half occupancy
+template<typename Size>
+Size num_slots_for(Size n)
+{
+  Size result = 16;
+
+  while(result < 2 * n)
+  {
+    result *= 2;
+  }
+
+  return result;
+}
+
+
+template<typename Size>
+Size num_partitions_for(Size num_slots)
+{
+  const Size result = num_slots / min_partition_size;
+
+  return (result < 1) ? Size(1) : (result < Size(max_partitions) ? result : Size(max_partitions));
+}
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Size>
+struct table_view
+{
+  typedef Key key_type;
+  typedef T   mapped_type;
+
+  Key *keys;
+  T *values;
+  unsigned char *states;
+  Size partition_size, num_partitions;
+  Hash hash;
+  KeyEqual key_eq;
+
+  __host__ __device__
+  uint64_t hash_of(const Key &key) const
+  {
+    return static_cast<uint64_t>(hash(key));
+  }
+
+  // the high bits of the hash select the partition, and the low bits the
+  // slot within it
+  __host__ __device__
+  Size partition_of(uint64_t h) const
+  {
+    return static_cast<Size>((h >> 56) & (num_partitions - 1));
+  }
+
+  // the slot of key, or the empty slot where it would be inserted. The
+  // keys and the states of the slots are separate arrays, so a probe scans
+  // them contiguously, and most probes end in the first slot
+  __host__ __device__
+  Size probe(const Key &key, uint64_t h) const
+  {
+    const Size mask = partition_size - 1;
+    const Size base = partition_of(h) * partition_size;
+
+    Size slot = static_cast<Size>(h) & mask;
+
+    while(states[base + slot] != 0 && !key_eq(keys[base + slot], key))
+    {
+      slot = (slot + 1) & mask;
+    }
+
+    return base + slot;
+  }
+};
+
+
+// counts the keys of every partition in every tile of the input
+template<typename View, typename RandomAccessIterator, typename Size>
+struct count_partitions
+{
+  View table;
+  RandomAccessIterator keys;
+  Size n, tile_size, num_tiles;
+  Size *counts;
+
+  __host__ __device__
+  void operator()(Size tile_idx) const
+  {
+    Size local_counts[max_partitions];
+
+    for(Size p = 0; p < table.num_partitions; ++p)
+    {
+      local_counts[p] = 0;
+    }
+
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    for(Size i = begin; i < end; ++i)
+    {
+      ++local_counts[table.partition_of(table.hash_of(keys[i]))];
+    }
+
+    for(Size p = 0; p < table.num_partitions; ++p)
+    {
+      counts[p * num_tiles + tile_idx] = local_counts[p];
+    }
+  }
+};
+
+
+// writes the positions of the keys of every partition to its part of the
+// permutation, in input order
+template<typename View, typename RandomAccessIterator, typename Size>
+struct scatter_partitions
+{
+  View table;
+  RandomAccessIterator keys;
+  Size n, tile_size, num_tiles;
+  const Size *offsets;
+  Size *permutation;
+
+  __host__ __device__
+  void operator()(Size tile_idx) const
+  {
+    Size cursors[max_partitions];
+
+    for(Size p = 0; p < table.num_partitions; ++p)
+    {
+      cursors[p] = offsets[p * num_tiles + tile_idx];
+    }
+
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    for(Size i = begin; i < end; ++i)
+    {
+      permutation[cursors[table.partition_of(table.hash_of(keys[i]))]++] = i;
+    }
+  }
+};
+
+
+// inserts the keys of a partition, in the order of its part of the
+// permutation, and updates its occupancy. A partition which fills past five
+// eighths of its slots stops, and reports the overflow
+template<typename View, typename RandomAccessIterator1, typename RandomAccessIterator2, typename IndexIterator, typename Size>
+struct insert_partitions
+{
+  View table;
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 values;
+  IndexIterator permutation;
+  const Size *offsets;
+  Size n, num_tiles;
+  Size *occupancy;
+  bool *overflow;
+
+  __host__ __device__
+  void operator()(Size partition_idx) const
+  {
+    const Size begin = (partition_idx == 0) ? Size(0) : offsets[partition_idx * num_tiles];
+    const Size end   = (partition_idx + 1 == table.num_partitions) ? n : offsets[(partition_idx + 1) * num_tiles];
+
+    const Size max_count = table.partition_size / 2 + table.partition_size / 8;
+
+    Size count = occupancy[partition_idx];
+
+    for(Size j = begin; j < end; ++j)
+    {
+      const Size i = permutation[j];
+
+      const typename View::key_type key = keys[i];
+
+      const Size slot = table.probe(key, table.hash_of(key));
+
+      if(table.states[slot] == 0)
+      {
+        if(count == max_count)
+        {
+          occupancy[partition_idx] = count;
+          overflow[partition_idx] = true;
+          return;
+        }
+
+        table.states[slot] = 1;
+        table.keys[slot]   = key;
+        table.values[slot] = values[i];
+
+        ++count;
+      }
+    }
+
+    occupancy[partition_idx] = count;
+    overflow[partition_idx] = false;
+  }
+};
+
+
+template<typename View, typename RandomAccessIterator1, typename RandomAccessIterator2>
+struct find_functor
+{
+  typedef typename View::mapped_type T;
+
+  View table;
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 result;
+  T default_value;
+
+  template<typename Size>
+  __host__ __device__
+  void operator()(Size i) const
+  {
+    const typename View::key_type key = keys[i];
+
+    const Size slot = table.probe(key, table.hash_of(key));
+
+    if(table.states[slot])
+    {
+      result[i] = table.values[slot];
+    }
+    else
+    {
+      result[i] = default_value;
+    }
+  }
+};
+
+
+template<typename View, typename RandomAccessIterator1, typename RandomAccessIterator2>
+struct contains_functor
+{
+  View table;
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 result;
+
+  template<typename Size>
+  __host__ __device__
+  void operator()(Size i) const
+  {
+    const typename View::key_type key = keys[i];
+
+    result[i] = table.states[table.probe(key, table.hash_of(key))] != 0;
+  }
+};
+
+
+} // end hash_map_detail
+} // end detail
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  hash_map<Key,T,Hash,KeyEqual,Allocator>
+    ::hash_map(void)
+      : m_keys(), m_values(), m_states(), m_occupancy(), m_size(0), m_hash(), m_key_eq(), m_alloc()
+{
+} // end hash_map::hash_map()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  hash_map<Key,T,Hash,KeyEqual,Allocator>
+    ::hash_map(size_type capacity,
+               const Hash &hash,
+               const KeyEqual &equal,
+               const Allocator &alloc)
+      : m_keys(key_allocator(alloc)),
+        m_values(mapped_allocator(alloc)),
+        m_states(state_allocator(alloc)),
+        m_occupancy(size_allocator(alloc)),
+        m_size(0),
+        m_hash(hash),
+        m_key_eq(equal),
+        m_alloc(alloc)
+{
+  if(capacity > 0)
+  {
+    const size_type num_slots = thrust::detail::hash_map_detail::num_slots_for(capacity);
+
+    m_keys.resize(num_slots);
+    m_values.resize(num_slots);
+    m_states.resize(num_slots, 0);
+    m_occupancy.resize(thrust::detail::hash_map_detail::num_partitions_for(num_slots), 0);
+  }
+} // end hash_map::hash_map()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  typename hash_map<Key,T,Hash,KeyEqual,Allocator>::size_type
+    hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::size(void) const
+{
+  return m_size;
+} // end hash_map::size()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  bool hash_map<Key,T,Hash,KeyEqual,Allocator>
+    ::empty(void) const
+{
+  return m_size == 0;
+} // end hash_map::empty()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  typename hash_map<Key,T,Hash,KeyEqual,Allocator>::size_type
+    hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::capacity(void) const
+{
+  return m_states.size() / 2;
+} // end hash_map::capacity()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  void hash_map<Key,T,Hash,KeyEqual,Allocator>
+    ::clear(void)
+{
+  thrust::fill(m_states.begin(), m_states.end(), 0);
+  thrust::fill(m_occupancy.begin(), m_occupancy.end(), 0);
+
+  m_size = 0;
+} // end hash_map::clear()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy>
+    void hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::reserve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                size_type n)
+{
+  if(n > capacity())
+  {
+    rehash(thrust::detail::derived_cast(thrust::detail::strip_const(exec)),
+           thrust::detail::hash_map_detail::num_slots_for(n));
+  }
+} // end hash_map::reserve()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  void hash_map<Key,T,Hash,KeyEqual,Allocator>
+    ::reserve(size_type n)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename key_storage::const_iterator>::type System;
+
+  System system;
+
+  reserve(select_system(system), n);
+} // end hash_map::reserve()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy>
+    void hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::rehash(thrust::execution_policy<DerivedPolicy> &exec,
+               size_type num_slots)
+{
+  const size_type n = m_size;
+
+  // set the elements aside
+  thrust::detail::temporary_array<Key,DerivedPolicy> keys(exec, n);
+  thrust::detail::temporary_array<T,DerivedPolicy>   values(exec, n);
+
+  thrust::copy_if(exec,
+                  thrust::make_zip_iterator(thrust::make_tuple(m_keys.begin(), m_values.begin())),
+                  thrust::make_zip_iterator(thrust::make_tuple(m_keys.end(),   m_values.end())),
+                  m_states.begin(),
+                  thrust::make_zip_iterator(thrust::make_tuple(keys.begin(), values.begin())),
+                  thrust::identity<unsigned char>());
+
+  // a partition may still fill up when the hashes are unbalanced
+  for(;; num_slots *= 2)
+  {
+    key_storage    new_keys(num_slots, key_allocator(m_alloc));
+    mapped_storage new_values(num_slots, mapped_allocator(m_alloc));
+    state_storage  new_states(num_slots, 0, state_allocator(m_alloc));
+    size_storage   new_occupancy(thrust::detail::hash_map_detail::num_partitions_for(num_slots), 0, size_allocator(m_alloc));
+
+    m_keys.swap(new_keys);
+    m_values.swap(new_values);
+    m_states.swap(new_states);
+    m_occupancy.swap(new_occupancy);
+
+    m_size = 0;
+
+    if(insert_into_partitions(exec, keys.begin(), n, values.begin())) break;
+  }
+} // end hash_map::rehash()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    bool hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::insert_into_partitions(thrust::execution_policy<DerivedPolicy> &exec,
+                               RandomAccessIterator1 keys_first,
+                               size_type n,
+                               RandomAccessIterator2 values_first)
+{
+  namespace ns = thrust::detail::hash_map_detail;
+
+  typedef ns::table_view<Key,T,Hash,KeyEqual,size_type> view_type;
+
+  if(n == 0) return true;
+
+  const size_type num_slots      = m_states.size();
+  const size_type num_partitions = ns::num_partitions_for(num_slots);
+
+  const view_type table = {thrust::raw_pointer_cast(m_keys.data()),
+                           thrust::raw_pointer_cast(m_values.data()),
+                           thrust::raw_pointer_cast(m_states.data()),
+                           num_slots / num_partitions, num_partitions, m_hash, m_key_eq};
+
+  thrust::detail::temporary_array<bool,DerivedPolicy> overflow(exec, num_partitions);
+
+  size_type *occupancy_ptr = thrust::raw_pointer_cast(m_occupancy.data());
+  bool *overflow_ptr       = thrust::raw_pointer_cast(&*overflow.begin());
+
+  if(num_partitions == 1)
+  {
+    // a single partition inserts the keys in input order
+    const ns::insert_partitions<view_type,RandomAccessIterator1,RandomAccessIterator2,thrust::counting_iterator<size_type>,size_type> f =
+      {table, keys_first, values_first, thrust::counting_iterator<size_type>(0), 0, n, 1, occupancy_ptr, overflow_ptr};
+
+    thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), 1, f);
+  }
+  else
+  {
+    size_type num_tiles = (n + ns::min_tile_size - 1) / ns::min_tile_size;
+    num_tiles = (num_tiles < size_type(ns::max_tiles)) ? num_tiles : size_type(ns::max_tiles);
+
+    const size_type tile_size = (n + num_tiles - 1) / num_tiles;
+
+    // tile_size is rounded up, so the last tiles may be empty
+    num_tiles = (n + tile_size - 1) / tile_size;
+
+    // group the positions of the keys by partition, in input order
+    thrust::detail::temporary_array<size_type,DerivedPolicy> offsets(exec, num_partitions * num_tiles);
+    thrust::detail::temporary_array<size_type,DerivedPolicy> permutation(exec, n);
+
+    size_type *offsets_ptr = thrust::raw_pointer_cast(&*offsets.begin());
+
+    const ns::count_partitions<view_type,RandomAccessIterator1,size_type> count =
+      {table, keys_first, n, tile_size, num_tiles, offsets_ptr};
+
+    thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), num_tiles, count);
+
+    thrust::exclusive_scan(exec, offsets.begin(), offsets.end(), offsets.begin());
+
+    const ns::scatter_partitions<view_type,RandomAccessIterator1,size_type> scatter =
+      {table, keys_first, n, tile_size, num_tiles, offsets_ptr, thrust::raw_pointer_cast(&*permutation.begin())};
+
+    thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), num_tiles, scatter);
+
+    const ns::insert_partitions<view_type,RandomAccessIterator1,RandomAccessIterator2,const size_type*,size_type> f =
+      {table, keys_first, values_first, thrust::raw_pointer_cast(&*permutation.begin()), offsets_ptr, n, num_tiles, occupancy_ptr, overflow_ptr};
+
+    thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), num_partitions, f);
+  }
+
+  m_size = thrust::reduce(exec, m_occupancy.begin(), m_occupancy.end());
+
+  return thrust::count(exec, overflow.begin(), overflow.end(), true) == 0;
+} // end hash_map::insert_into_partitions()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    void hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::insert(const thrust::detail::execution_policy_base<DerivedPolicy> &exec_base,
+               RandomAccessIterator1 keys_first,
+               RandomAccessIterator1 keys_last,
+               RandomAccessIterator2 values_first)
+{
+  namespace ns = thrust::detail::hash_map_detail;
+
+  thrust::execution_policy<DerivedPolicy> &exec = thrust::detail::derived_cast(thrust::detail::strip_const(exec_base));
+
+  const size_type n = thrust::distance(keys_first, keys_last);
+
+  if(n == 0) return;
+
+  if(m_states.empty())
+  {
+    rehash(exec, ns::num_slots_for(n));
+  }
+
+  // the keys which were inserted before the map filled up are found again
+  // when the insertion is repeated
+  while(!insert_into_partitions(exec, keys_first, n, values_first))
+  {
+    const size_type num_slots = ns::num_slots_for(m_size + n);
+
+    rehash(exec, (num_slots > m_states.size()) ? num_slots : 2 * m_states.size());
+  }
+} // end hash_map::insert()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    void hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::insert(RandomAccessIterator1 keys_first,
+               RandomAccessIterator1 keys_last,
+               RandomAccessIterator2 values_first)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename key_storage::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type               System2;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type               System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  insert(select_system(system1,system2,system3), keys_first, keys_last, values_first);
+} // end hash_map::insert()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::find(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+             RandomAccessIterator1 keys_first,
+             RandomAccessIterator1 keys_last,
+             RandomAccessIterator2 result,
+             const T &default_value) const
+{
+  namespace ns = thrust::detail::hash_map_detail;
+
+  typedef ns::table_view<Key,T,Hash,KeyEqual,size_type> view_type;
+
+  const size_type n = thrust::distance(keys_first, keys_last);
+
+  if(m_size == 0)
+  {
+    return thrust::fill_n(exec, result, n, default_value);
+  }
+
+  const size_type num_partitions = ns::num_partitions_for(m_states.size());
+
+  const view_type table = {const_cast<Key*>(thrust::raw_pointer_cast(m_keys.data())),
+                           const_cast<T*>(thrust::raw_pointer_cast(m_values.data())),
+                           const_cast<unsigned char*>(thrust::raw_pointer_cast(m_states.data())),
+                           m_states.size() / num_partitions, num_partitions, m_hash, m_key_eq};
+
+  const ns::find_functor<view_type,RandomAccessIterator1,RandomAccessIterator2> f =
+    {table, keys_first, result, default_value};
+
+  thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), n, f);
+
+  return result + n;
+} // end hash_map::find()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::find(RandomAccessIterator1 keys_first,
+             RandomAccessIterator1 keys_last,
+             RandomAccessIterator2 result,
+             const T &default_value) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename key_storage::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type               System2;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type               System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return find(select_system(system1,system2,system3), keys_first, keys_last, result, default_value);
+} // end hash_map::find()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::contains(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 RandomAccessIterator1 keys_first,
+                 RandomAccessIterator1 keys_last,
+                 RandomAccessIterator2 result) const
+{
+  namespace ns = thrust::detail::hash_map_detail;
+
+  typedef ns::table_view<Key,T,Hash,KeyEqual,size_type> view_type;
+
+  const size_type n = thrust::distance(keys_first, keys_last);
+
+  if(m_size == 0)
+  {
+    return thrust::fill_n(exec, result, n, false);
+  }
+
+  const size_type num_partitions = ns::num_partitions_for(m_states.size());
+
+  const view_type table = {const_cast<Key*>(thrust::raw_pointer_cast(m_keys.data())),
+                           const_cast<T*>(thrust::raw_pointer_cast(m_values.data())),
+                           const_cast<unsigned char*>(thrust::raw_pointer_cast(m_states.data())),
+                           m_states.size() / num_partitions, num_partitions, m_hash, m_key_eq};
+
+  const ns::contains_functor<view_type,RandomAccessIterator1,RandomAccessIterator2> f =
+    {table, keys_first, result};
+
+  thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), n, f);
+
+  return result + n;
+} // end hash_map::contains()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::contains(RandomAccessIterator1 keys_first,
+                 RandomAccessIterator1 keys_last,
+                 RandomAccessIterator2 result) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename key_storage::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type               System2;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type               System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return contains(select_system(system1,system2,system3), keys_first, keys_last, result);
+} // end hash_map::contains()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename DerivedPolicy, typename OutputIterator1, typename OutputIterator2>
+    thrust::pair<OutputIterator1,OutputIterator2>
+      hash_map<Key,T,Hash,KeyEqual,Allocator>
+        ::copy(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+               OutputIterator1 keys_result,
+               OutputIterator2 values_result) const
+{
+  typedef thrust::tuple<OutputIterator1,OutputIterator2> iterator_tuple;
+
+  iterator_tuple result =
+    thrust::copy_if(exec,
+                    thrust::make_zip_iterator(thrust::make_tuple(m_keys.begin(), m_values.begin())),
+                    thrust::make_zip_iterator(thrust::make_tuple(m_keys.end(),   m_values.end())),
+                    m_states.begin(),
+                    thrust::make_zip_iterator(thrust::make_tuple(keys_result, values_result)),
+                    thrust::identity<unsigned char>()).get_iterator_tuple();
+
+  return thrust::make_pair(thrust::get<0>(result), thrust::get<1>(result));
+} // end hash_map::copy()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  template<typename OutputIterator1, typename OutputIterator2>
+    thrust::pair<OutputIterator1,OutputIterator2>
+      hash_map<Key,T,Hash,KeyEqual,Allocator>
+        ::copy(OutputIterator1 keys_result,
+               OutputIterator2 values_result) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename key_storage::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<OutputIterator1>::type                     System2;
+  typedef typename thrust::iterator_system<OutputIterator2>::type                     System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return copy(select_system(system1,system2,system3), keys_result, values_result);
+} // end hash_map::copy()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  typename hash_map<Key,T,Hash,KeyEqual,Allocator>::hasher
+    hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::hash_function(void) const
+{
+  return m_hash;
+} // end hash_map::hash_function()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  typename hash_map<Key,T,Hash,KeyEqual,Allocator>::key_equal
+    hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::key_eq(void) const
+{
+  return m_key_eq;
+} // end hash_map::key_eq()
+
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+  typename hash_map<Key,T,Hash,KeyEqual,Allocator>::allocator_type
+    hash_map<Key,T,Hash,KeyEqual,Allocator>
+      ::get_allocator(void) const
+{
+  return m_alloc;
+} // end hash_map::get_allocator()
+
+
+} // end thrust
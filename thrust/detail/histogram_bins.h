@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file histogram_bins.h
+ *  \brief Functions which map samples to the bins of a histogram.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+
+namespace thrust
+{
+namespace detail
+{
+
+
+// maps a sample to its bin among num_bins bins of equal width which divide
+// [lower, upper), or to num_bins when the sample is outside of the range.
+// The bin is computed without branches, so that loops which bin contiguous
+// samples may be vectorized
+template<typename Level, typename Size>
+struct even_bins
+{
+  Level lower, upper;
+  Size num_bins;
+
+  // num_bins / (upper - lower), for floating point levels
+  Level scale;
+
+  __host__ __device__
+  even_bins(Level lower, Level upper, Size num_bins)
+    : lower(lower), upper(upper), num_bins(num_bins),
+      scale(compute_scale(typename thrust::detail::is_floating_point<Level>::type()))
+  {}
+
+  template<typename T>
+  __host__ __device__
+  Size operator()(const T &sample) const
+  {
+    const Level x = sample;
+
+    // NaNs are outside of every range
+    const bool in_range = (lower <= x) && (x < upper);
+
+    return in_range ? bin(x, typename thrust::detail::is_floating_point<Level>::type()) : num_bins;
+  }
+
+  private:
+    __host__ __device__
+    Level compute_scale(thrust::detail::true_type) const
+    {
+      return Level(num_bins) / (upper - lower);
+    }
+
+    __host__ __device__
+    Level compute_scale(thrust::detail::false_type) const
+    {
+      return Level(0);
+    }
+
+    __host__ __device__
+    Size bin(Level x, thrust::detail::true_type) const
+    {
+      const Size result = static_cast<Size>((x - lower) * scale);
+
+      // samples just below upper may round up to num_bins
+      return (result < num_bins) ? result : num_bins - 1;
+    }
+
+    // the difference of two integers is exact in unsigned 64 bit
+    // arithmetic, even when it overflows Level
+    __host__ __device__
+    Size bin(Level x, thrust::detail::false_type) const
+    {
+      const uint64_t offset = static_cast<uint64_t>(x) - static_cast<uint64_t>(lower);
+      const uint64_t range  = static_cast<uint64_t>(upper) - static_cast<uint64_t>(lower);
+
+      return static_cast<Size>(offset * static_cast<uint64_t>(num_bins) / range);
+    }
+};
+
+
+// maps a sample to the bin i of the sorted levels for which
+// levels[i] <= sample < levels[i + 1], or to num_levels - 1 when the
+// sample is outside of [levels[0], levels[num_levels - 1])
+template<typename RandomAccessIterator, typename Size>
+struct range_bins
+{
+  RandomAccessIterator levels;
+  Size num_levels;
+
+  template<typename T>
+  __host__ __device__
+  Size operator()(const T &sample) const
+  {
+    const Size num_bins = num_levels - 1;
+
+    if(sample < levels[0] || !(sample < levels[num_bins]))
+    {
+      return num_bins;
+    }
+
+    // a binary search without branches: the number of steps only depends on
+    // the number of levels
+    Size result = 0;
+
+    for(Size size = num_bins; size > 1; )
+    {
+      const Size half = size / 2;
+
+      result = (sample < levels[result + half]) ? result : result + half;
+      size  -= half;
+    }
+
+    return result;
+  }
+};
+
+
+} // end detail
+} // end thrust
+
@@ -138,6 +138,48 @@ __host__ __device__
 } // end reduce_by_key()
 
 
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                         InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output)
+{
+  using thrust::system::detail::generic::reduce_by_key_unsorted;
+  return reduce_by_key_unsorted(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_last, values_first, keys_output, values_output);
+} // end reduce_by_key_unsorted()
+
+
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                         InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output,
+                         BinaryFunction binary_op)
+{
+  using thrust::system::detail::generic::reduce_by_key_unsorted;
+  return reduce_by_key_unsorted(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), keys_first, keys_last, values_first, keys_output, values_output, binary_op);
+} // end reduce_by_key_unsorted()
+
+
 template<typename InputIterator>
 typename thrust::iterator_traits<InputIterator>::value_type
   reduce(InputIterator first,
@@ -274,5 +316,61 @@ template<typename InputIterator1,
 }
 
 
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2>
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<InputIterator1>::type  System1;
+  typedef typename thrust::iterator_system<InputIterator2>::type  System2;
+  typedef typename thrust::iterator_system<OutputIterator1>::type System3;
+  typedef typename thrust::iterator_system<OutputIterator2>::type System4;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+  System4 system4;
+
+  return thrust::reduce_by_key_unsorted(select_system(system1,system2,system3,system4), keys_first, keys_last, values_first, keys_output, values_output);
+}
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output,
+                         BinaryFunction binary_op)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<InputIterator1>::type  System1;
+  typedef typename thrust::iterator_system<InputIterator2>::type  System2;
+  typedef typename thrust::iterator_system<OutputIterator1>::type System3;
+  typedef typename thrust::iterator_system<OutputIterator2>::type System4;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+  System4 system4;
+
+  return thrust::reduce_by_key_unsorted(select_system(system1,system2,system3,system4), keys_first, keys_last, values_first, keys_output, values_output, binary_op);
+}
+
+
 } // end namespace thrust
 
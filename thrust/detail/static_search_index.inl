@@ -0,0 +1,497 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file static_search_index.inl
+ *  \brief Inline file for static_search_index.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/static_search_index.h>
+#include <thrust/gather.h>
+#include <thrust/for_each.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+namespace thrust
+{
+namespace detail
+{
+namespace static_search_index_detail
+{
+
+
+template<typename Size>
+__host__ __device__
+Size floor_log2(Size x)
+{
+  Size result = 0;
+
+  while(x >>= 1)
+  {
+    ++result;
+  }
+
+  return result;
+}
+
+
+// maps the breadth first position k (counting from 1) of a node of the
+// complete binary search tree over n elements to the node's position in the
+// ordered range
+template<typename Size>
+struct eytzinger_rank
+{
+  Size height;
+
+  // the number of nodes on the bottom level of the tree
+  Size num_leaves;
+
+  __host__ __device__
+  explicit eytzinger_rank(Size n)
+    : height(floor_log2(n)),
+      num_leaves(n - (Size(1) << height) + 1)
+  {}
+
+  // the position of node k at the given depth
+  __host__ __device__
+  Size operator()(Size k, Size depth) const
+  {
+    // the node's position were the bottom level full
+    const Size position = ((2 * (k - (Size(1) << depth)) + 1) << (height - depth)) - 1;
+
+    // nodes of the missing part of the bottom level would sit at the even
+    // positions from 2 * num_leaves on
+    const Size missing_before = (position + 1) / 2;
+
+    return (missing_before > num_leaves) ? position - (missing_before - num_leaves) : position;
+  }
+
+  __host__ __device__
+  Size operator()(Size k) const
+  {
+    return operator()(k, floor_log2(k));
+  }
+};
+
+
+// the number of queries searched in lockstep: every level of their searches
+// issues independent loads, so their cache misses overlap
+const int batch_size = 16;
+
+
+// the element at position i of the ordered range goes before value when
+// lower_bound(value) > i
+struct lower_bound_search
+{
+  template<typename Compare, typename T, typename U>
+  __host__ __device__
+  static bool goes_before(Compare &comp, const T &element, const U &value)
+  {
+    return comp(element, value);
+  }
+};
+
+
+// the element at position i of the ordered range goes before value when
+// upper_bound(value) > i
+struct upper_bound_search
+{
+  template<typename Compare, typename T, typename U>
+  __host__ __device__
+  static bool goes_before(Compare &comp, const T &element, const U &value)
+  {
+    return !comp(value, element);
+  }
+};
+
+
+template<typename Search, typename T, typename Size, typename StrictWeakOrdering>
+struct tree_search
+{
+  const T *layout;
+  Size n;
+  StrictWeakOrdering comp;
+
+  // writes the positions in the ordered range of the Count values at values
+  __thrust_exec_check_disable__
+  template<int Count, typename RandomAccessIterator>
+  __host__ __device__
+  void search(RandomAccessIterator values, Size *result) const
+  {
+    thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+    Size k[Count];
+
+    for(int j = 0; j < Count; ++j)
+    {
+      k[j] = 1;
+    }
+
+    // the first levels of the tree are full, so every search descends
+    // through all of them
+    const Size full_levels = floor_log2(n + 1);
+
+    for(Size level = 0; level < full_levels; ++level)
+    {
+      for(int j = 0; j < Count; ++j)
+      {
+        k[j] = 2 * k[j] + (Search::goes_before(wrapped_comp, layout[k[j] - 1], values[j]) ? 1 : 0);
+      }
+    }
+
+    const eytzinger_rank<Size> rank(n);
+
+    for(int j = 0; j < Count; ++j)
+    {
+      Size node  = k[j];
+      Size depth = full_levels;
+
+      // the bottom level may be partial
+      if(node <= n)
+      {
+        node = 2 * node + (Search::goes_before(wrapped_comp, layout[node - 1], values[j]) ? 1 : 0);
+        ++depth;
+      }
+
+      // the result is the last node at which the search went left, i.e. the
+      // node above the trailing right turns
+      while(node & 1)
+      {
+        node >>= 1;
+        --depth;
+      }
+
+      node >>= 1;
+
+      result[j] = (node == 0) ? n : rank(node, depth - 1);
+    }
+  }
+
+  // the batch size is a constant of the searches of full batches, so that
+  // their loops over the batch unroll
+  template<typename RandomAccessIterator>
+  __host__ __device__
+  void operator()(RandomAccessIterator values, int count, Size *result) const
+  {
+    if(count == batch_size)
+    {
+      search<batch_size>(values, result);
+    }
+    else
+    {
+      for(int j = 0; j < count; ++j)
+      {
+        search<1>(values + j, result + j);
+      }
+    }
+  }
+};
+
+
+template<typename Search, typename T, typename Size, typename StrictWeakOrdering,
+         typename RandomAccessIterator1, typename RandomAccessIterator2>
+struct bound_functor
+{
+  tree_search<Search,T,Size,StrictWeakOrdering> search;
+  RandomAccessIterator1 values;
+  RandomAccessIterator2 result;
+  Size num_values;
+
+  __thrust_exec_check_disable__
+  __host__ __device__
+  void operator()(Size batch) const
+  {
+    const Size begin = batch * batch_size;
+    const int  count = (num_values - begin < Size(batch_size)) ? int(num_values - begin) : batch_size;
+
+    Size positions[batch_size];
+
+    search(values + begin, count, positions);
+
+    for(int j = 0; j < count; ++j)
+    {
+      result[begin + j] = positions[j];
+    }
+  }
+};
+
+
+template<typename T, typename Size, typename StrictWeakOrdering,
+         typename RandomAccessIterator1, typename RandomAccessIterator2>
+struct equal_range_functor
+{
+  tree_search<lower_bound_search,T,Size,StrictWeakOrdering> lower;
+  tree_search<upper_bound_search,T,Size,StrictWeakOrdering> upper;
+  RandomAccessIterator1 values;
+  RandomAccessIterator2 result;
+  Size num_values;
+
+  __thrust_exec_check_disable__
+  __host__ __device__
+  void operator()(Size batch) const
+  {
+    const Size begin = batch * batch_size;
+    const int  count = (num_values - begin < Size(batch_size)) ? int(num_values - begin) : batch_size;
+
+    Size lower_positions[batch_size];
+    Size upper_positions[batch_size];
+
+    lower(values + begin, count, lower_positions);
+    upper(values + begin, count, upper_positions);
+
+    for(int j = 0; j < count; ++j)
+    {
+      result[begin + j] = thrust::pair<Size,Size>(lower_positions[j], upper_positions[j]);
+    }
+  }
+};
+
+
+template<typename Size>
+__host__ __device__
+Size num_batches(Size n)
+{
+  return (n + batch_size - 1) / batch_size;
+}
+
+
+} // end static_search_index_detail
+} // end detail
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  static_search_index<T,StrictWeakOrdering,Allocator>
+    ::static_search_index(void)
+      : m_layout(), m_comp()
+{
+} // end static_search_index::static_search_index()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator>
+    static_search_index<T,StrictWeakOrdering,Allocator>
+      ::static_search_index(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                            RandomAccessIterator first,
+                            RandomAccessIterator last,
+                            StrictWeakOrdering comp)
+        : m_layout(static_cast<size_type>(last - first)), m_comp(comp)
+{
+  build(exec, first);
+} // end static_search_index::static_search_index()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename RandomAccessIterator>
+    static_search_index<T,StrictWeakOrdering,Allocator>
+      ::static_search_index(RandomAccessIterator first,
+                            RandomAccessIterator last,
+                            StrictWeakOrdering comp)
+        : m_layout(static_cast<size_type>(last - first)), m_comp(comp)
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<RandomAccessIterator>::type System;
+
+  System system;
+
+  build(select_system(system), first);
+} // end static_search_index::static_search_index()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator>
+    void static_search_index<T,StrictWeakOrdering,Allocator>
+      ::build(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+              RandomAccessIterator first)
+{
+  typedef thrust::detail::static_search_index_detail::eytzinger_rank<size_type> rank_function;
+
+  const rank_function rank(m_layout.size());
+
+  // the element at breadth first position k is the one of rank(k) in the
+  // ordered range
+  thrust::gather(exec,
+                 thrust::make_transform_iterator(thrust::counting_iterator<size_type>(1), rank),
+                 thrust::make_transform_iterator(thrust::counting_iterator<size_type>(1 + m_layout.size()), rank),
+                 first,
+                 m_layout.begin());
+} // end static_search_index::build()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  typename static_search_index<T,StrictWeakOrdering,Allocator>::size_type
+    static_search_index<T,StrictWeakOrdering,Allocator>
+      ::size(void) const
+{
+  return m_layout.size();
+} // end static_search_index::size()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  bool static_search_index<T,StrictWeakOrdering,Allocator>
+    ::empty(void) const
+{
+  return m_layout.empty();
+} // end static_search_index::empty()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 static_search_index<T,StrictWeakOrdering,Allocator>
+      ::lower_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  RandomAccessIterator1 values_first,
+                  RandomAccessIterator1 values_last,
+                  RandomAccessIterator2 result) const
+{
+  namespace ns = thrust::detail::static_search_index_detail;
+
+  typedef ns::tree_search<ns::lower_bound_search,T,size_type,StrictWeakOrdering> search_function;
+
+  const size_type num_values = thrust::distance(values_first, values_last);
+
+  const search_function search = {thrust::raw_pointer_cast(m_layout.data()), m_layout.size(), m_comp};
+
+  const ns::bound_functor<ns::lower_bound_search,T,size_type,StrictWeakOrdering,RandomAccessIterator1,RandomAccessIterator2> f =
+    {search, values_first, result, num_values};
+
+  thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), ns::num_batches(num_values), f);
+
+  return result + num_values;
+} // end static_search_index::lower_bound()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 static_search_index<T,StrictWeakOrdering,Allocator>
+      ::lower_bound(RandomAccessIterator1 values_first,
+                  RandomAccessIterator1 values_last,
+                  RandomAccessIterator2 result) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename storage_type::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type                  System2;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type                  System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return lower_bound(select_system(system1,system2,system3), values_first, values_last, result);
+} // end static_search_index::lower_bound()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 static_search_index<T,StrictWeakOrdering,Allocator>
+      ::upper_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  RandomAccessIterator1 values_first,
+                  RandomAccessIterator1 values_last,
+                  RandomAccessIterator2 result) const
+{
+  namespace ns = thrust::detail::static_search_index_detail;
+
+  typedef ns::tree_search<ns::upper_bound_search,T,size_type,StrictWeakOrdering> search_function;
+
+  const size_type num_values = thrust::distance(values_first, values_last);
+
+  const search_function search = {thrust::raw_pointer_cast(m_layout.data()), m_layout.size(), m_comp};
+
+  const ns::bound_functor<ns::upper_bound_search,T,size_type,StrictWeakOrdering,RandomAccessIterator1,RandomAccessIterator2> f =
+    {search, values_first, result, num_values};
+
+  thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), ns::num_batches(num_values), f);
+
+  return result + num_values;
+} // end static_search_index::upper_bound()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 static_search_index<T,StrictWeakOrdering,Allocator>
+      ::upper_bound(RandomAccessIterator1 values_first,
+                  RandomAccessIterator1 values_last,
+                  RandomAccessIterator2 result) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename storage_type::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type                  System2;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type                  System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return upper_bound(select_system(system1,system2,system3), values_first, values_last, result);
+} // end static_search_index::upper_bound()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 static_search_index<T,StrictWeakOrdering,Allocator>
+      ::equal_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                  RandomAccessIterator1 values_first,
+                  RandomAccessIterator1 values_last,
+                  RandomAccessIterator2 result) const
+{
+  namespace ns = thrust::detail::static_search_index_detail;
+
+  typedef ns::tree_search<ns::lower_bound_search,T,size_type,StrictWeakOrdering> lower_search;
+  typedef ns::tree_search<ns::upper_bound_search,T,size_type,StrictWeakOrdering> upper_search;
+
+  const size_type num_values = thrust::distance(values_first, values_last);
+
+  const lower_search lower = {thrust::raw_pointer_cast(m_layout.data()), m_layout.size(), m_comp};
+  const upper_search upper = {thrust::raw_pointer_cast(m_layout.data()), m_layout.size(), m_comp};
+
+  const ns::equal_range_functor<T,size_type,StrictWeakOrdering,RandomAccessIterator1,RandomAccessIterator2> f =
+    {lower, upper, values_first, result, num_values};
+
+  thrust::for_each_n(exec, thrust::counting_iterator<size_type>(0), ns::num_batches(num_values), f);
+
+  return result + num_values;
+} // end static_search_index::equal_range()
+
+
+template<typename T, typename StrictWeakOrdering, typename Allocator>
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 static_search_index<T,StrictWeakOrdering,Allocator>
+      ::equal_range(RandomAccessIterator1 values_first,
+                  RandomAccessIterator1 values_last,
+                  RandomAccessIterator2 result) const
+{
+  using thrust::system::detail::generic::select_system;
+
+  typedef typename thrust::iterator_system<typename storage_type::const_iterator>::type System1;
+  typedef typename thrust::iterator_system<RandomAccessIterator1>::type                  System2;
+  typedef typename thrust::iterator_system<RandomAccessIterator2>::type                  System3;
+
+  System1 system1;
+  System2 system2;
+  System3 system3;
+
+  return equal_range(select_system(system1,system2,system3), values_first, values_last, result);
+} // end static_search_index::equal_range()
+
+} // end thrust
+
@@ -0,0 +1,389 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file hash_map.h
+ *  \brief An associative container of unique keys for bulk parallel
+ *         insertions and lookups
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/arithmetic_hash.h>
+#include <thrust/detail/allocator/allocator_traits.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/detail/vector_base.h>
+#include <thrust/device_allocator.h>
+#include <thrust/functional.h>
+#include <thrust/pair.h>
+
+namespace thrust
+{
+
+
+/*! \addtogroup container_classes Container Classes
+ *  \{
+ */
+
+
+/*! \p hash_map is an associative container which maps unique keys to
+ *  values. Its elements are inserted and looked up in bulk: every operation
+ *  on a range of keys is a parallel algorithm, executed as determined by the
+ *  execution policy passed to it. The versions without an execution policy
+ *  execute on the system of the map's memory and of the iterators passed
+ *  to them.
+ *
+ *  The map is an open addressing hash table with linear probing. Its keys,
+ *  values and slot states are stored in separate arrays, so that a lookup
+ *  scans contiguous keys and touches a single value. The slots
+ *  are divided into partitions by the high bits of the hashes of the keys,
+ *  which bulk insertions fill in parallel, one partition at a time, so
+ *  that they need no atomic operations. The map grows as needed to keep
+ *  about half of its slots empty.
+ *
+ *  \tparam Key The type of the keys of the map. \p Key must be default
+ *          constructible and assignable.
+ *  \tparam T The type of the values of the map. \p T must be default
+ *          constructible and assignable.
+ *  \tparam Hash A function object which returns a 64 bit unsigned integer
+ *          hash of a \p Key. Keys which are equal according to \p KeyEqual
+ *          must have equal hashes. The default hash accepts arithmetic
+ *          types.
+ *  \tparam KeyEqual A model of <a href="http://www.sgi.com/tech/stl/BinaryPredicate.html">Binary Predicate</a>
+ *          which tests keys for equality.
+ *  \tparam Allocator The allocator of the map's memory, which is rebound to
+ *          the types of its keys, values and slot states. The memory must
+ *          be accessible to the execution policies used with the map.
+ *
+ *  The following code snippet demonstrates how to use a \p hash_map to
+ *  join two sequences of keys.
+ *
+ *  \code
+ *  #include <thrust/hash_map.h>
+ *  #include <thrust/device_vector.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  int build_keys[3]   = {7, 1, 4};
+ *  int build_values[3] = {70, 10, 40};
+ *
+ *  thrust::device_vector<int> keys(build_keys, build_keys + 3);
+ *  thrust::device_vector<int> values(build_values, build_values + 3);
+ *
+ *  thrust::hash_map<int,int> map;
+ *  map.insert(thrust::device, keys.begin(), keys.end(), values.begin());
+ *
+ *  int probe_keys[4] = {4, 5, 7, 7};
+ *  thrust::device_vector<int> probes(probe_keys, probe_keys + 4);
+ *
+ *  thrust::device_vector<bool> found(4);
+ *  thrust::device_vector<int>  result(4);
+ *
+ *  map.contains(thrust::device, probes.begin(), probes.end(), found.begin());
+ *  map.find(thrust::device, probes.begin(), probes.end(), result.begin(), -1);
+ *
+ *  // found is now  [true, false, true, true]
+ *  // result is now [40, -1, 70, 70]
+ *  \endcode
+ */
+template<typename Key,
+         typename T,
+         typename Hash = thrust::detail::arithmetic_hash<Key>,
+         typename KeyEqual = thrust::equal_to<Key>,
+         typename Allocator = thrust::device_allocator<Key> >
+  class hash_map
+{
+  private:
+    typedef typename thrust::detail::allocator_traits_detail::rebind_alloc<Allocator,Key>::type           key_allocator;
+    typedef typename thrust::detail::allocator_traits_detail::rebind_alloc<Allocator,T>::type             mapped_allocator;
+    typedef typename thrust::detail::allocator_traits_detail::rebind_alloc<Allocator,unsigned char>::type state_allocator;
+
+    typedef thrust::detail::vector_base<Key,key_allocator>              key_storage;
+    typedef thrust::detail::vector_base<T,mapped_allocator>             mapped_storage;
+    typedef thrust::detail::vector_base<unsigned char,state_allocator>  state_storage;
+
+    typedef typename thrust::detail::allocator_traits_detail::rebind_alloc<Allocator,typename key_storage::size_type>::type size_allocator;
+
+    typedef thrust::detail::vector_base<typename key_storage::size_type,size_allocator> size_storage;
+
+  public:
+    /*! \cond
+     */
+    typedef Key                                key_type;
+    typedef T                                  mapped_type;
+    typedef Hash                               hasher;
+    typedef KeyEqual                           key_equal;
+    typedef Allocator                          allocator_type;
+    typedef typename key_storage::size_type    size_type;
+    /*! \endcond
+     */
+
+    /*! This constructor creates an empty \p hash_map.
+     */
+    hash_map(void);
+
+    /*! This constructor creates an empty \p hash_map with room for
+     *  \p capacity elements.
+     *
+     *  \param capacity The number of elements the map holds at half occupancy.
+     *  \param hash The hash of the keys.
+     *  \param equal The equality of the keys.
+     *  \param alloc The allocator of the map's memory.
+     */
+    explicit hash_map(size_type capacity,
+                      const Hash &hash = Hash(),
+                      const KeyEqual &equal = KeyEqual(),
+                      const Allocator &alloc = Allocator());
+
+    /*! Returns the number of elements in the map.
+     */
+    size_type size(void) const;
+
+    /*! Returns <tt>size() == 0</tt>.
+     */
+    bool empty(void) const;
+
+    /*! Returns the number of elements the map holds at half occupancy.
+     *  The map grows when a part of its slots fills past five eighths, so
+     *  its size may exceed its capacity.
+     */
+    size_type capacity(void) const;
+
+    /*! Removes all the elements of the map. The capacity is unchanged.
+     */
+    void clear(void);
+
+    /*! Grows the map, if needed, so that its capacity is at least \p n.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param n The number of elements.
+     */
+    template<typename DerivedPolicy>
+    __host__
+    void reserve(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 size_type n);
+
+    /*! Grows the map, if needed, so that its capacity is at least \p n.
+     *
+     *  \param n The number of elements.
+     */
+    void reserve(size_type n);
+
+    /*! Inserts every key in <tt>[keys_first, keys_last)</tt> which is not in
+     *  the map yet, with its corresponding value in the range beginning at
+     *  \p values_first. When a key appears several times in the input, the
+     *  value of its first appearance is inserted.
+     *
+     *  If the map fills up during the insertion, it grows to hold
+     *  <tt>size() + (keys_last - keys_first)</tt> elements, so that every key
+     *  may be new, and the insertion is repeated. A map without capacity
+     *  grows to that size first. \p reserve the expected number of
+     *  distinct keys beforehand when the input has many duplicates.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the input key range.
+     *  \param keys_last The end of the input key range.
+     *  \param values_first The beginning of the input value range.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and its \c value_type is convertible to \p Key.
+     *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and its \c value_type is convertible to \p T.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    __host__
+    void insert(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                RandomAccessIterator1 keys_first,
+                RandomAccessIterator1 keys_last,
+                RandomAccessIterator2 values_first);
+
+    /*! Inserts every key in <tt>[keys_first, keys_last)</tt> which is not in
+     *  the map yet, with its corresponding value in the range beginning at
+     *  \p values_first. When a key appears several times in the input, the
+     *  value of its first appearance is inserted.
+     *
+     *  \param keys_first The beginning of the input key range.
+     *  \param keys_last The end of the input key range.
+     *  \param values_first The beginning of the input value range.
+     */
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    void insert(RandomAccessIterator1 keys_first,
+                RandomAccessIterator1 keys_last,
+                RandomAccessIterator2 values_first);
+
+    /*! For every key in <tt>[keys_first, keys_last)</tt>, writes the value
+     *  it maps to, or \p default_value when it is not in the map.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the key range.
+     *  \param keys_last The end of the key range.
+     *  \param result The beginning of the output sequence.
+     *  \param default_value The value written for keys which are not in the map.
+     *  \return The end of the output sequence.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and its \c value_type is convertible to \p Key.
+     *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and \p T is convertible to its \c value_type.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    __host__
+    RandomAccessIterator2 find(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                               RandomAccessIterator1 keys_first,
+                               RandomAccessIterator1 keys_last,
+                               RandomAccessIterator2 result,
+                               const T &default_value = T()) const;
+
+    /*! For every key in <tt>[keys_first, keys_last)</tt>, writes the value
+     *  it maps to, or \p default_value when it is not in the map.
+     *
+     *  \param keys_first The beginning of the key range.
+     *  \param keys_last The end of the key range.
+     *  \param result The beginning of the output sequence.
+     *  \param default_value The value written for keys which are not in the map.
+     *  \return The end of the output sequence.
+     */
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 find(RandomAccessIterator1 keys_first,
+                               RandomAccessIterator1 keys_last,
+                               RandomAccessIterator2 result,
+                               const T &default_value = T()) const;
+
+    /*! For every key in <tt>[keys_first, keys_last)</tt>, writes whether it
+     *  is in the map.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_first The beginning of the key range.
+     *  \param keys_last The end of the key range.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and its \c value_type is convertible to \p Key.
+     *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and \c bool is convertible to its \c value_type.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    __host__
+    RandomAccessIterator2 contains(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                   RandomAccessIterator1 keys_first,
+                                   RandomAccessIterator1 keys_last,
+                                   RandomAccessIterator2 result) const;
+
+    /*! For every key in <tt>[keys_first, keys_last)</tt>, writes whether it
+     *  is in the map.
+     *
+     *  \param keys_first The beginning of the key range.
+     *  \param keys_last The end of the key range.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     */
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 contains(RandomAccessIterator1 keys_first,
+                                   RandomAccessIterator1 keys_last,
+                                   RandomAccessIterator2 result) const;
+
+    /*! Copies the keys of the map, and the values they map to, in an
+     *  unspecified order.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param keys_result The beginning of the output key range.
+     *  \param values_result The beginning of the output value range.
+     *  \return A pair of iterators at the ends of the output ranges.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam OutputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>,
+     *          and \p Key is convertible to its \c value_type.
+     *  \tparam OutputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a>,
+     *          and \p T is convertible to its \c value_type.
+     */
+    template<typename DerivedPolicy, typename OutputIterator1, typename OutputIterator2>
+    __host__
+    thrust::pair<OutputIterator1,OutputIterator2>
+      copy(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+           OutputIterator1 keys_result,
+           OutputIterator2 values_result) const;
+
+    /*! Copies the keys of the map, and the values they map to, in an
+     *  unspecified order.
+     *
+     *  \param keys_result The beginning of the output key range.
+     *  \param values_result The beginning of the output value range.
+     *  \return A pair of iterators at the ends of the output ranges.
+     */
+    template<typename OutputIterator1, typename OutputIterator2>
+    thrust::pair<OutputIterator1,OutputIterator2>
+      copy(OutputIterator1 keys_result,
+           OutputIterator2 values_result) const;
+
+    /*! Returns the hash of the keys.
+     */
+    hasher hash_function(void) const;
+
+    /*! Returns the equality of the keys.
+     */
+    key_equal key_eq(void) const;
+
+    /*! Returns a copy of the allocator of the map's memory.
+     */
+    allocator_type get_allocator(void) const;
+
+  private:
+    key_storage    m_keys;
+    mapped_storage m_values;
+
+    // nonzero for occupied slots
+    state_storage  m_states;
+
+    // the number of occupied slots of every partition
+    size_storage   m_occupancy;
+
+    size_type m_size;
+
+    Hash m_hash;
+
+    KeyEqual m_key_eq;
+
+    Allocator m_alloc;
+
+    // replaces the slots with num_slots empty ones, and inserts the elements
+    // back
+    template<typename DerivedPolicy>
+    __host__
+    void rehash(thrust::execution_policy<DerivedPolicy> &exec,
+                size_type num_slots);
+
+    // returns false when a partition fills up before every key is inserted
+    template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    __host__
+    bool insert_into_partitions(thrust::execution_policy<DerivedPolicy> &exec,
+                                RandomAccessIterator1 keys_first,
+                                size_type n,
+                                RandomAccessIterator2 values_first);
+};
+
+
+/*! \} // end container_classes
+ */
+
+
+} // end thrust
+
+#include <thrust/detail/hash_map.inl>
+
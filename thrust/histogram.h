@@ -0,0 +1,308 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file histogram.h
+ *  \brief Counting the elements of a range which fall into bins
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+
+namespace thrust
+{
+
+
+/*! \addtogroup algorithms
+ */
+
+/*! \addtogroup reductions
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \addtogroup counting
+ *  \ingroup reductions
+ *  \{
+ */
+
+
+/*! \p histogram_even counts the elements of <tt>[first, last)</tt> which
+ *  fall into each of \p num_bins bins of equal width, which divide the
+ *  interval <tt>[lower_level, upper_level)</tt>. Bin \c i counts the
+ *  elements \c x for which
+ *  <tt>lower_level + i * (upper_level - lower_level) / num_bins <= x</tt> and
+ *  <tt>x < lower_level + (i + 1) * (upper_level - lower_level) / num_bins</tt>.
+ *  The count of bin \c i is assigned to <tt>histogram[i]</tt>. Elements
+ *  outside of <tt>[lower_level, upper_level)</tt> are not counted.
+ *
+ *  Unlike a histogram built out of \p sort and \p upper_bound, the input is
+ *  neither copied nor sorted: the bin of every element is computed
+ *  directly, and each thread counts into bins of its own, which are summed
+ *  at the end.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param histogram The beginning of the histogram.
+ *  \param num_bins The number of bins.
+ *  \param lower_level The lower bound, inclusive, of the first bin.
+ *  \param upper_level The upper bound, exclusive, of the last bin.
+ *  \return <tt>histogram + num_bins</tt>
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \c InputIterator's \c value_type is convertible to \p Level.
+ *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          and \c RandomAccessIterator is mutable, and \c RandomAccessIterator's \c value_type is an arithmetic type.
+ *  \tparam Size is an integral type.
+ *  \tparam Level is an arithmetic type. When \p Level is an integral type,
+ *          <tt>(upper_level - lower_level) * num_bins</tt> must fit into 64 bits.
+ *
+ *  \pre The range <tt>[histogram, histogram + num_bins)</tt> shall not overlap the range <tt>[first, last)</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_even to
+ *  count the elements of a sequence which fall into four bins of width 5
+ *  using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  float data[8] = {0.5f, 18.0f, 3.5f, 7.0f, 12.0f, 2.0f, 25.0f, -1.0f};
+ *  int histogram[4];
+ *
+ *  thrust::histogram_even(thrust::host, data, data + 8, histogram, 4, 0.0f, 20.0f);
+ *
+ *  // histogram is now {3, 1, 1, 1}
+ *  \endcode
+ *
+ *  \see histogram_range
+ *  \see count
+ */
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename Level>
+__host__ __device__
+  RandomAccessIterator histogram_even(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      Level lower_level,
+                                      Level upper_level);
+
+
+/*! \p histogram_even counts the elements of <tt>[first, last)</tt> which
+ *  fall into each of \p num_bins bins of equal width, which divide the
+ *  interval <tt>[lower_level, upper_level)</tt>. Bin \c i counts the
+ *  elements \c x for which
+ *  <tt>lower_level + i * (upper_level - lower_level) / num_bins <= x</tt> and
+ *  <tt>x < lower_level + (i + 1) * (upper_level - lower_level) / num_bins</tt>.
+ *  The count of bin \c i is assigned to <tt>histogram[i]</tt>. Elements
+ *  outside of <tt>[lower_level, upper_level)</tt> are not counted.
+ *
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param histogram The beginning of the histogram.
+ *  \param num_bins The number of bins.
+ *  \param lower_level The lower bound, inclusive, of the first bin.
+ *  \param upper_level The upper bound, exclusive, of the last bin.
+ *  \return <tt>histogram + num_bins</tt>
+ *
+ *  \tparam InputIterator is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \c InputIterator's \c value_type is convertible to \p Level.
+ *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          and \c RandomAccessIterator is mutable, and \c RandomAccessIterator's \c value_type is an arithmetic type.
+ *  \tparam Size is an integral type.
+ *  \tparam Level is an arithmetic type. When \p Level is an integral type,
+ *          <tt>(upper_level - lower_level) * num_bins</tt> must fit into 64 bits.
+ *
+ *  \pre The range <tt>[histogram, histogram + num_bins)</tt> shall not overlap the range <tt>[first, last)</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_even to
+ *  count the integers of a sequence which fall into the bins
+ *  <tt>[0, 10)</tt> and <tt>[10, 20)</tt>.
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::device_vector<int> data(5);
+ *  data[0] = 3; data[1] = 14; data[2] = 9; data[3] = 20; data[4] = 10;
+ *
+ *  thrust::device_vector<unsigned int> histogram(2);
+ *
+ *  thrust::histogram_even(data.begin(), data.end(), histogram.begin(), 2, 0, 20);
+ *
+ *  // histogram is now {2, 2}
+ *  \endcode
+ *
+ *  \see histogram_range
+ *  \see count
+ */
+template<typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename Level>
+  RandomAccessIterator histogram_even(InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      Level lower_level,
+                                      Level upper_level);
+
+
+/*! \p histogram_range counts the elements of <tt>[first, last)</tt> which
+ *  fall into each of the bins delimited by the sorted levels
+ *  <tt>[levels_first, levels_last)</tt>. Bin \c i counts the elements \c x
+ *  for which <tt>levels_first[i] <= x</tt> and <tt>x < levels_first[i + 1]</tt>,
+ *  and its count is assigned to <tt>histogram[i]</tt>, so that
+ *  <tt>(levels_last - levels_first) - 1</tt> counts are assigned. Elements
+ *  outside of <tt>[*levels_first, *(levels_last - 1))</tt> are not counted.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param levels_first The beginning of the sequence of levels.
+ *  \param levels_last The end of the sequence of levels.
+ *  \param histogram The beginning of the histogram.
+ *  \return <tt>histogram + (levels_last - levels_first) - 1</tt>, or
+ *          \p histogram when there are fewer than two levels.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \c InputIterator's \c value_type is <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>
+ *          with \c RandomAccessIterator1's \c value_type.
+ *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          and \c RandomAccessIterator2 is mutable, and \c RandomAccessIterator2's \c value_type is an arithmetic type.
+ *
+ *  \pre The levels shall be sorted in ascending order.
+ *  \pre The range <tt>[histogram, histogram + (levels_last - levels_first) - 1)</tt> shall not overlap the ranges
+ *       <tt>[first, last)</tt> or <tt>[levels_first, levels_last)</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_range to
+ *  count the elements of a sequence which fall into bins of different
+ *  widths using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  float data[8] = {0.5f, 18.0f, 3.5f, 7.0f, 12.0f, 2.0f, 25.0f, -1.0f};
+ *  float levels[4] = {0.0f, 1.0f, 10.0f, 20.0f};
+ *  int histogram[3];
+ *
+ *  thrust::histogram_range(thrust::host, data, data + 8, levels, levels + 4, histogram);
+ *
+ *  // histogram is now {1, 3, 2}
+ *  \endcode
+ *
+ *  \see histogram_even
+ *  \see upper_bound
+ */
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+__host__ __device__
+  RandomAccessIterator2 histogram_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                        InputIterator first,
+                                        InputIterator last,
+                                        RandomAccessIterator1 levels_first,
+                                        RandomAccessIterator1 levels_last,
+                                        RandomAccessIterator2 histogram);
+
+
+/*! \p histogram_range counts the elements of <tt>[first, last)</tt> which
+ *  fall into each of the bins delimited by the sorted levels
+ *  <tt>[levels_first, levels_last)</tt>. Bin \c i counts the elements \c x
+ *  for which <tt>levels_first[i] <= x</tt> and <tt>x < levels_first[i + 1]</tt>,
+ *  and its count is assigned to <tt>histogram[i]</tt>, so that
+ *  <tt>(levels_last - levels_first) - 1</tt> counts are assigned. Elements
+ *  outside of <tt>[*levels_first, *(levels_last - 1))</tt> are not counted.
+ *
+ *  \param first The beginning of the input sequence.
+ *  \param last The end of the input sequence.
+ *  \param levels_first The beginning of the sequence of levels.
+ *  \param levels_last The end of the sequence of levels.
+ *  \param histogram The beginning of the histogram.
+ *  \return <tt>histogram + (levels_last - levels_first) - 1</tt>, or
+ *          \p histogram when there are fewer than two levels.
+ *
+ *  \tparam InputIterator is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \c InputIterator's \c value_type is <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>
+ *          with \c RandomAccessIterator1's \c value_type.
+ *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>.
+ *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+ *          and \c RandomAccessIterator2 is mutable, and \c RandomAccessIterator2's \c value_type is an arithmetic type.
+ *
+ *  \pre The levels shall be sorted in ascending order.
+ *  \pre The range <tt>[histogram, histogram + (levels_last - levels_first) - 1)</tt> shall not overlap the ranges
+ *       <tt>[first, last)</tt> or <tt>[levels_first, levels_last)</tt>.
+ *
+ *  The following code snippet demonstrates how to use \p histogram_range to
+ *  count the elements of a sequence which fall into bins of different
+ *  widths.
+ *
+ *  \code
+ *  #include <thrust/histogram.h>
+ *  #include <thrust/device_vector.h>
+ *  ...
+ *  thrust::device_vector<int> data(5);
+ *  data[0] = 3; data[1] = 14; data[2] = 9; data[3] = 20; data[4] = 100;
+ *
+ *  thrust::device_vector<int> levels(3);
+ *  levels[0] = 0; levels[1] = 4; levels[2] = 100;
+ *
+ *  thrust::device_vector<unsigned int> histogram(2);
+ *
+ *  thrust::histogram_range(data.begin(), data.end(), levels.begin(), levels.end(), histogram.begin());
+ *
+ *  // histogram is now {1, 3}
+ *  \endcode
+ *
+ *  \see histogram_even
+ *  \see upper_bound
+ */
+template<typename InputIterator,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+  RandomAccessIterator2 histogram_range(InputIterator first,
+                                        InputIterator last,
+                                        RandomAccessIterator1 levels_first,
+                                        RandomAccessIterator1 levels_last,
+                                        RandomAccessIterator2 histogram);
+
+
+/*! \} // end counting
+ *  \} // end reductions
+ */
+
+
+} // end namespace thrust
+
+#include <thrust/detail/histogram.inl>
+
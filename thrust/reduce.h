@@ -775,6 +775,267 @@ template<typename InputIterator1,
                 BinaryFunction binary_op);
 
 
+/*! \p reduce_by_key_unsorted is a generalization of \p reduce_by_key to
+ *  keys in any order. For each group of equal keys in the range
+ *  <tt>[keys_first, keys_last)</tt>, wherever they are in the range,
+ *  \p reduce_by_key_unsorted copies the key to \c keys_output. The
+ *  corresponding values are reduced using \c plus, in the order they appear in
+ *  the input, and the result copied to \c values_output at the same position
+ *  as the key.
+ *
+ *  Unlike \p reduce_by_key, which requires equal keys to be consecutive,
+ *  \p reduce_by_key_unsorted does not require the keys to be sorted first.
+ *  The order of the groups in the output is unspecified.
+ *
+ *  This version of \p reduce_by_key_unsorted uses <tt>operator==</tt> to test
+ *  for equality and \c plus to reduce values with equal keys.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the input key range.
+ *  \param keys_last  The end of the input key range.
+ *  \param values_first The beginning of the input value range.
+ *  \param keys_output The beginning of the output key range.
+ *  \param values_output The beginning of the output value range.
+ *  \return A pair of iterators at end of the ranges <tt>[keys_output, keys_output_last)</tt> and <tt>[values_output, values_output_last)</tt>.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/EqualityComparable.html">Equality Comparable</a>
+ *          and <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *  \tparam OutputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator1's \c value_type is convertible to \c OutputIterator1's \c value_type.
+ *  \tparam OutputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator2's \c value_type is convertible to \c OutputIterator2's \c value_type.
+ *
+ *  \pre The input ranges shall not overlap either output range.
+ *
+ *  The following code snippet demonstrates how to use \p reduce_by_key_unsorted
+ *  to sum the values of every key of an unsorted sequence of key/value pairs
+ *  using the \p thrust::host execution policy for parallelization:
+ *
+ *  \code
+ *  #include <thrust/reduce.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {1, 3, 3, 2, 3, 2, 1}; // input keys
+ *  int B[N] = {9, 8, 7, 6, 5, 4, 3}; // input values
+ *  int C[N];                         // output keys
+ *  int D[N];                         // output values
+ *
+ *  thrust::pair<int*,int*> new_end;
+ *  new_end = thrust::reduce_by_key_unsorted(thrust::host, A, A + N, B, C, D);
+ *
+ *  // new_end.first - C is 3 and new_end.second - D is 3.
+ *  // The first three keys in C are {1, 2, 3} in some order, and the first
+ *  // three values in D are their sums {12, 10, 20} in the same order.
+ *  \endcode
+ *
+ *  \see reduce_by_key
+ *  \see sort_by_key
+ */
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                         InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output);
+
+
+/*! \p reduce_by_key_unsorted is a generalization of \p reduce_by_key to
+ *  keys in any order. For each group of equal keys in the range
+ *  <tt>[keys_first, keys_last)</tt>, wherever they are in the range,
+ *  \p reduce_by_key_unsorted copies the key to \c keys_output. The
+ *  corresponding values are reduced using \c plus, in the order they appear in
+ *  the input, and the result copied to \c values_output at the same position
+ *  as the key.
+ *
+ *  Unlike \p reduce_by_key, which requires equal keys to be consecutive,
+ *  \p reduce_by_key_unsorted does not require the keys to be sorted first.
+ *  The order of the groups in the output is unspecified.
+ *
+ *  This version of \p reduce_by_key_unsorted uses <tt>operator==</tt> to test
+ *  for equality and \c plus to reduce values with equal keys.
+ *
+ *  \param keys_first The beginning of the input key range.
+ *  \param keys_last  The end of the input key range.
+ *  \param values_first The beginning of the input value range.
+ *  \param keys_output The beginning of the output key range.
+ *  \param values_output The beginning of the output value range.
+ *  \return A pair of iterators at end of the ranges <tt>[keys_output, keys_output_last)</tt> and <tt>[values_output, values_output_last)</tt>.
+ *
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/EqualityComparable.html">Equality Comparable</a>
+ *          and <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *  \tparam OutputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator1's \c value_type is convertible to \c OutputIterator1's \c value_type.
+ *  \tparam OutputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator2's \c value_type is convertible to \c OutputIterator2's \c value_type.
+ *
+ *  \pre The input ranges shall not overlap either output range.
+ *
+ *  \see reduce_by_key
+ *  \see sort_by_key
+ */
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2>
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output);
+
+
+/*! \p reduce_by_key_unsorted is a generalization of \p reduce_by_key to
+ *  keys in any order. For each group of equal keys in the range
+ *  <tt>[keys_first, keys_last)</tt>, wherever they are in the range,
+ *  \p reduce_by_key_unsorted copies the key to \c keys_output. The
+ *  corresponding values are reduced using \c binary_op, in the order they appear in
+ *  the input, and the result copied to \c values_output at the same position
+ *  as the key.
+ *
+ *  Unlike \p reduce_by_key, which requires equal keys to be consecutive,
+ *  \p reduce_by_key_unsorted does not require the keys to be sorted first.
+ *  The order of the groups in the output is unspecified.
+ *
+ *  This version of \p reduce_by_key_unsorted uses <tt>operator==</tt> to test
+ *  for equality and \c binary_op to reduce values with equal keys.
+ *
+ *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  \param exec The execution policy to use for parallelization.
+ *  \param keys_first The beginning of the input key range.
+ *  \param keys_last  The end of the input key range.
+ *  \param values_first The beginning of the input value range.
+ *  \param keys_output The beginning of the output key range.
+ *  \param values_output The beginning of the output value range.
+ *  \param binary_op The binary function used to accumulate values.
+ *  \return A pair of iterators at end of the ranges <tt>[keys_output, keys_output_last)</tt> and <tt>[values_output, values_output_last)</tt>.
+ *
+ *  \tparam DerivedPolicy The name of the derived execution policy.
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/EqualityComparable.html">Equality Comparable</a>
+ *          and <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *  \tparam OutputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator1's \c value_type is convertible to \c OutputIterator1's \c value_type.
+ *  \tparam OutputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator2's \c value_type is convertible to \c OutputIterator2's \c value_type.
+ *  \tparam BinaryFunction is a model of <a href="http://www.sgi.com/tech/stl/BinaryFunction.html">Binary Function</a>
+ *          and \c BinaryFunction's \c result_type is convertible to \c OutputIterator2's \c value_type.
+ *
+ *  \pre The input ranges shall not overlap either output range.
+ *
+ *  \see reduce_by_key
+ *  \see sort_by_key
+ */
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                         InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output,
+                         BinaryFunction binary_op);
+
+
+/*! \p reduce_by_key_unsorted is a generalization of \p reduce_by_key to
+ *  keys in any order. For each group of equal keys in the range
+ *  <tt>[keys_first, keys_last)</tt>, wherever they are in the range,
+ *  \p reduce_by_key_unsorted copies the key to \c keys_output. The
+ *  corresponding values are reduced using \c binary_op, in the order they appear in
+ *  the input, and the result copied to \c values_output at the same position
+ *  as the key.
+ *
+ *  Unlike \p reduce_by_key, which requires equal keys to be consecutive,
+ *  \p reduce_by_key_unsorted does not require the keys to be sorted first.
+ *  The order of the groups in the output is unspecified.
+ *
+ *  This version of \p reduce_by_key_unsorted uses <tt>operator==</tt> to test
+ *  for equality and \c binary_op to reduce values with equal keys.
+ *
+ *  \param keys_first The beginning of the input key range.
+ *  \param keys_last  The end of the input key range.
+ *  \param values_first The beginning of the input value range.
+ *  \param keys_output The beginning of the output key range.
+ *  \param values_output The beginning of the output value range.
+ *  \param binary_op The binary function used to accumulate values.
+ *  \return A pair of iterators at end of the ranges <tt>[keys_output, keys_output_last)</tt> and <tt>[values_output, values_output_last)</tt>.
+ *
+ *  \tparam InputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *          and \p InputIterator1's \c value_type is a model of <a href="http://www.sgi.com/tech/stl/EqualityComparable.html">Equality Comparable</a>
+ *          and <a href="http://www.sgi.com/tech/stl/LessThanComparable.html">LessThan Comparable</a>.
+ *  \tparam InputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/InputIterator.html">Input Iterator</a>,
+ *  \tparam OutputIterator1 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator1's \c value_type is convertible to \c OutputIterator1's \c value_type.
+ *  \tparam OutputIterator2 is a model of <a href="http://www.sgi.com/tech/stl/OutputIterator.html">Output Iterator</a> and
+ *          and \p InputIterator2's \c value_type is convertible to \c OutputIterator2's \c value_type.
+ *  \tparam BinaryFunction is a model of <a href="http://www.sgi.com/tech/stl/BinaryFunction.html">Binary Function</a>
+ *          and \c BinaryFunction's \c result_type is convertible to \c OutputIterator2's \c value_type.
+ *
+ *  \pre The input ranges shall not overlap either output range.
+ *
+ *  The following code snippet demonstrates how to use \p reduce_by_key_unsorted
+ *  to find the largest value of every key of an unsorted sequence of
+ *  key/value pairs.
+ *
+ *  \code
+ *  #include <thrust/reduce.h>
+ *  #include <thrust/functional.h>
+ *  ...
+ *  const int N = 7;
+ *  int A[N] = {1, 3, 3, 2, 3, 2, 1}; // input keys
+ *  int B[N] = {9, 8, 7, 6, 5, 4, 3}; // input values
+ *  int C[N];                         // output keys
+ *  int D[N];                         // output values
+ *
+ *  thrust::pair<int*,int*> new_end;
+ *  thrust::maximum<int> binary_op;
+ *  new_end = thrust::reduce_by_key_unsorted(A, A + N, B, C, D, binary_op);
+ *
+ *  // new_end.first - C is 3 and new_end.second - D is 3.
+ *  // The first three keys in C are {1, 2, 3} in some order, and the first
+ *  // three values in D are their maxima {9, 6, 8} in the same order.
+ *  \endcode
+ *
+ *  \see reduce_by_key
+ *  \see sort_by_key
+ */
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+  thrust::pair<OutputIterator1,OutputIterator2>
+  reduce_by_key_unsorted(InputIterator1 keys_first,
+                         InputIterator1 keys_last,
+                         InputIterator2 values_first,
+                         OutputIterator1 keys_output,
+                         OutputIterator2 values_output,
+                         BinaryFunction binary_op);
+
+
 /*! \} // end reductions
  */
 
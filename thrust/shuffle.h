@@ -44,6 +44,11 @@ namespace thrust {
  *
  *  The algorithm's execution is parallelized as determined by \p exec.
  *
+ *  For a given state of \p g, the permutation is the same regardless of the number of threads
+ *  used, and \p shuffle and \p shuffle_copy produce the same permutation. The permutation may
+ *  differ between systems, e.g. the OpenMP and TBB systems produce different permutations than the
+ *  CPP and CUDA systems.
+ *
  *  \param exec The execution policy to use for parallelization.
  *  \param first The beginning of the sequence to shuffle.
  *  \param last The end of the sequence to shuffle.
@@ -107,6 +112,11 @@ __host__ __device__ void shuffle(RandomIterator first, RandomIterator last,
  *  random engine \p g.
  *
  *  The algorithm's execution is parallelized as determined by \p exec.
+ *
+ *  For a given state of \p g, the permutation is the same regardless of the number of threads
+ *  used, and \p shuffle and \p shuffle_copy produce the same permutation. The permutation may
+ *  differ between systems, e.g. the OpenMP and TBB systems produce different permutations than the
+ *  CPP and CUDA systems.
 
  *  \param exec The execution policy to use for parallelization.
  *  \param first The beginning of the sequence to shuffle.
@@ -0,0 +1,290 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file static_search_index.h
+ *  \brief A read-only index for repeated binary searches of an ordered range
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/detail/vector_base.h>
+#include <thrust/device_allocator.h>
+#include <thrust/functional.h>
+#include <thrust/pair.h>
+
+namespace thrust
+{
+
+
+/*! \addtogroup searching
+ *  \{
+ */
+
+
+/*! \p static_search_index is a read-only copy of an ordered range, laid out
+ *  for fast batches of binary searches. The elements are stored in the
+ *  breadth first order of the implicit binary search tree over the range
+ *  (the Eytzinger layout). The first levels of the tree therefore share a
+ *  few cache lines, and every search of the index descends through the same
+ *  number of levels, so that batches of searches proceed in lockstep and
+ *  their cache misses overlap.
+ *
+ *  The results of the searches are positions in the ordered range the index
+ *  was built from, so they are the same as those of the vectorized versions
+ *  of \p lower_bound, \p upper_bound and \p equal_range over that range.
+ *
+ *  Building the index and searching it are parallel algorithms, executed as
+ *  determined by the execution policy passed to them. The versions without
+ *  an execution policy execute on the system of the index's memory. The
+ *  elements are stored in the memory of \p Allocator, which must be
+ *  accessible to the execution policies used with the index.
+ *
+ *  \tparam T The type of the elements of the index.
+ *  \tparam StrictWeakOrdering The ordering of the range the index is built
+ *          from, a model of <a href="http://www.sgi.com/tech/stl/StrictWeakOrdering.html">Strict Weak Ordering</a>.
+ *  \tparam Allocator The allocator of the index's memory.
+ *
+ *  The following code snippet demonstrates how to use a
+ *  \p static_search_index to search for many values in a sorted range.
+ *
+ *  \code
+ *  #include <thrust/static_search_index.h>
+ *  #include <thrust/device_vector.h>
+ *  #include <thrust/execution_policy.h>
+ *  ...
+ *  thrust::device_vector<int> table(5);
+ *  table[0] = 0;
+ *  table[1] = 2;
+ *  table[2] = 5;
+ *  table[3] = 7;
+ *  table[4] = 8;
+ *
+ *  thrust::static_search_index<int> index(thrust::device, table.begin(), table.end());
+ *
+ *  thrust::device_vector<int> values(6);
+ *  values[0] = 0;
+ *  values[1] = 1;
+ *  values[2] = 2;
+ *  values[3] = 3;
+ *  values[4] = 8;
+ *  values[5] = 9;
+ *
+ *  thrust::device_vector<unsigned int> output(6);
+ *
+ *  index.lower_bound(thrust::device, values.begin(), values.end(), output.begin());
+ *
+ *  // output is now [0, 1, 1, 2, 4, 5]
+ *  \endcode
+ *
+ *  \see lower_bound
+ *  \see upper_bound
+ *  \see equal_range
+ */
+template<typename T,
+         typename StrictWeakOrdering = thrust::less<T>,
+         typename Allocator = thrust::device_allocator<T> >
+  class static_search_index
+{
+  private:
+    typedef thrust::detail::vector_base<T,Allocator> storage_type;
+
+  public:
+    /*! \cond
+     */
+    typedef T                                  value_type;
+    typedef StrictWeakOrdering                 value_compare;
+    typedef Allocator                          allocator_type;
+    typedef typename storage_type::size_type   size_type;
+    /*! \endcond
+     */
+
+    /*! This constructor creates an empty \p static_search_index.
+     */
+    static_search_index(void);
+
+    /*! This constructor builds a \p static_search_index from an ordered range.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param first The beginning of the ordered range.
+     *  \param last The end of the ordered range.
+     *  \param comp The ordering of the range.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and its \c value_type is convertible to \p T.
+     *
+     *  \pre <tt>[first, last)</tt> is ordered according to \p comp.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator>
+    __host__
+    static_search_index(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                        RandomAccessIterator first,
+                        RandomAccessIterator last,
+                        StrictWeakOrdering comp = StrictWeakOrdering());
+
+    /*! This constructor builds a \p static_search_index from an ordered
+     *  range, in parallel on the system of \p first.
+     *
+     *  \param first The beginning of the ordered range.
+     *  \param last The end of the ordered range.
+     *  \param comp The ordering of the range.
+     *
+     *  \tparam RandomAccessIterator is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and its \c value_type is convertible to \p T.
+     *
+     *  \pre <tt>[first, last)</tt> is ordered according to \p comp.
+     */
+    template<typename RandomAccessIterator>
+    static_search_index(RandomAccessIterator first,
+                        RandomAccessIterator last,
+                        StrictWeakOrdering comp = StrictWeakOrdering());
+
+    /*! Returns the number of elements in the index.
+     */
+    size_type size(void) const;
+
+    /*! Returns <tt>size() == 0</tt>.
+     */
+    bool empty(void) const;
+
+    /*! For every value in <tt>[values_first, values_last)</tt>, writes the
+     *  position in the indexed range at which \p lower_bound finds it.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>.
+     *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and \p size_type is convertible to \c RandomAccessIterator2's \c value_type.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    __host__
+    RandomAccessIterator2 lower_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                      RandomAccessIterator1 values_first,
+                                      RandomAccessIterator1 values_last,
+                                      RandomAccessIterator2 result) const;
+
+    /*! For every value in <tt>[values_first, values_last)</tt>, writes the
+     *  position in the indexed range at which \p lower_bound finds it.
+     *
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     */
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 lower_bound(RandomAccessIterator1 values_first,
+                                      RandomAccessIterator1 values_last,
+                                      RandomAccessIterator2 result) const;
+
+    /*! For every value in <tt>[values_first, values_last)</tt>, writes the
+     *  position in the indexed range at which \p upper_bound finds it.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>.
+     *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and \p size_type is convertible to \c RandomAccessIterator2's \c value_type.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    __host__
+    RandomAccessIterator2 upper_bound(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                      RandomAccessIterator1 values_first,
+                                      RandomAccessIterator1 values_last,
+                                      RandomAccessIterator2 result) const;
+
+    /*! For every value in <tt>[values_first, values_last)</tt>, writes the
+     *  position in the indexed range at which \p upper_bound finds it.
+     *
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     */
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 upper_bound(RandomAccessIterator1 values_first,
+                                      RandomAccessIterator1 values_last,
+                                      RandomAccessIterator2 result) const;
+
+    /*! For every value in <tt>[values_first, values_last)</tt>, writes the
+     *  pair of positions in the indexed range at which \p lower_bound and
+     *  \p upper_bound find it.
+     *
+     *  \param exec The execution policy to use for parallelization.
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     *
+     *  \tparam DerivedPolicy The name of the derived execution policy.
+     *  \tparam RandomAccessIterator1 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>.
+     *  \tparam RandomAccessIterator2 is a model of <a href="http://www.sgi.com/tech/stl/RandomAccessIterator.html">Random Access Iterator</a>,
+     *          and <tt>thrust::pair<size_type,size_type></tt> is convertible to \c RandomAccessIterator2's \c value_type.
+     */
+    template<typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2>
+    __host__
+    RandomAccessIterator2 equal_range(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                                      RandomAccessIterator1 values_first,
+                                      RandomAccessIterator1 values_last,
+                                      RandomAccessIterator2 result) const;
+
+    /*! For every value in <tt>[values_first, values_last)</tt>, writes the
+     *  pair of positions in the indexed range at which \p lower_bound and
+     *  \p upper_bound find it.
+     *
+     *  \param values_first The beginning of the search values sequence.
+     *  \param values_last The end of the search values sequence.
+     *  \param result The beginning of the output sequence.
+     *  \return The end of the output sequence.
+     */
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    RandomAccessIterator2 equal_range(RandomAccessIterator1 values_first,
+                                      RandomAccessIterator1 values_last,
+                                      RandomAccessIterator2 result) const;
+
+  private:
+    // the elements in breadth first order
+    storage_type m_layout;
+
+    StrictWeakOrdering m_comp;
+
+    template<typename DerivedPolicy, typename RandomAccessIterator>
+    __host__
+    void build(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+               RandomAccessIterator first);
+};
+
+
+/*! \} // end searching
+ */
+
+
+} // end thrust
+
+#include <thrust/detail/static_search_index.inl>
+
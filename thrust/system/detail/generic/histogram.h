@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file histogram.h
+ *  \brief Generic implementations of histogram functions.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/tag.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename Level>
+__host__ __device__
+  RandomAccessIterator histogram_even(thrust::execution_policy<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      Level lower_level,
+                                      Level upper_level);
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+__host__ __device__
+  RandomAccessIterator2 histogram_range(thrust::execution_policy<DerivedPolicy> &exec,
+                                        InputIterator first,
+                                        InputIterator last,
+                                        RandomAccessIterator1 levels_first,
+                                        RandomAccessIterator1 levels_last,
+                                        RandomAccessIterator2 histogram);
+
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
+#include <thrust/system/detail/generic/histogram.inl>
+
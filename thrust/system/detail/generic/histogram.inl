@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file histogram.inl
+ *  \brief Inline file for histogram.h.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/system/detail/generic/histogram.h>
+#include <thrust/detail/histogram_bins.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/adjacent_difference.h>
+#include <thrust/binary_search.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/sort.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace histogram_detail
+{
+
+
+// sorts the bins of the samples, so that the end of every bin is found with
+// a binary search. Samples outside of the bins are in bin num_bins, past the
+// end of the last bin
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Bins,
+         typename Size>
+__host__ __device__
+  RandomAccessIterator bin_histogram(thrust::execution_policy<DerivedPolicy> &exec,
+                                     InputIterator first,
+                                     InputIterator last,
+                                     RandomAccessIterator histogram,
+                                     Bins bins,
+                                     Size num_bins)
+{
+  if(num_bins <= 0) return histogram;
+
+  const typename thrust::iterator_difference<InputIterator>::type n = thrust::distance(first, last);
+
+  typedef thrust::transform_iterator<Bins,InputIterator,Size,Size> BinIterator;
+
+  thrust::detail::temporary_array<Size,DerivedPolicy> sample_bins(exec, BinIterator(first, bins), n);
+
+  thrust::sort(exec, sample_bins.begin(), sample_bins.end());
+
+  thrust::detail::temporary_array<Size,DerivedPolicy> bin_ends(exec, num_bins);
+
+  thrust::upper_bound(exec,
+                      sample_bins.begin(), sample_bins.end(),
+                      thrust::counting_iterator<Size>(0), thrust::counting_iterator<Size>(num_bins),
+                      bin_ends.begin());
+
+  thrust::adjacent_difference(exec, bin_ends.begin(), bin_ends.end(), histogram);
+
+  return histogram + num_bins;
+} // end bin_histogram()
+
+
+} // end histogram_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename Level>
+__host__ __device__
+  RandomAccessIterator histogram_even(thrust::execution_policy<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      Level lower_level,
+                                      Level upper_level)
+{
+  return histogram_detail::bin_histogram(exec, first, last, histogram,
+                                         thrust::detail::even_bins<Level,Size>(lower_level, upper_level, num_bins),
+                                         num_bins);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+__host__ __device__
+  RandomAccessIterator2 histogram_range(thrust::execution_policy<DerivedPolicy> &exec,
+                                        InputIterator first,
+                                        InputIterator last,
+                                        RandomAccessIterator1 levels_first,
+                                        RandomAccessIterator1 levels_last,
+                                        RandomAccessIterator2 histogram)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size num_levels = levels_last - levels_first;
+
+  if(num_levels < 2) return histogram;
+
+  const thrust::detail::range_bins<RandomAccessIterator1,Size> bins = {levels_first, num_levels};
+
+  return histogram_detail::bin_histogram(exec, first, last, histogram, bins, num_levels - 1);
+} // end histogram_range()
+
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
@@ -80,6 +80,37 @@ __host__ __device__
                   BinaryFunction binary_op);
 
 
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_unsorted(thrust::execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 keys_first,
+                           InputIterator1 keys_last,
+                           InputIterator2 values_first,
+                           OutputIterator1 keys_output,
+                           OutputIterator2 values_output);
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_unsorted(thrust::execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 keys_first,
+                           InputIterator1 keys_last,
+                           InputIterator2 values_first,
+                           OutputIterator1 keys_output,
+                           OutputIterator2 values_output,
+                           BinaryFunction binary_op);
+
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
@@ -34,6 +34,8 @@
 #include <thrust/detail/internal_functional.h>
 #include <thrust/scan.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/sort.h>
 
 namespace thrust
 {
@@ -190,6 +192,67 @@ __host__ __device__
 } // end reduce_by_key()
 
 
+template<typename ExecutionPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_unsorted(thrust::execution_policy<ExecutionPolicy> &exec,
+                           InputIterator1 keys_first,
+                           InputIterator1 keys_last,
+                           InputIterator2 values_first,
+                           OutputIterator1 keys_output,
+                           OutputIterator2 values_output)
+{
+  typedef typename thrust::detail::eval_if<
+    thrust::detail::is_output_iterator<OutputIterator2>::value,
+    thrust::iterator_value<InputIterator2>,
+    thrust::iterator_value<OutputIterator2>
+  >::type T;
+
+  // use plus<T> as default BinaryFunction
+  return thrust::reduce_by_key_unsorted(exec, keys_first, keys_last, values_first, keys_output, values_output, thrust::plus<T>());
+} // end reduce_by_key_unsorted()
+
+
+template<typename ExecutionPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+__host__ __device__
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_unsorted(thrust::execution_policy<ExecutionPolicy> &exec,
+                           InputIterator1 keys_first,
+                           InputIterator1 keys_last,
+                           InputIterator2 values_first,
+                           OutputIterator1 keys_output,
+                           OutputIterator2 values_output,
+                           BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_value<InputIterator1>::type KeyType;
+
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator2>::type ValueType;
+
+  typedef typename thrust::iterator_traits<InputIterator1>::difference_type difference_type;
+
+  const difference_type n = thrust::distance(keys_first, keys_last);
+
+  // group equal keys with a stable sort of copies of the input, so that the
+  // values of every key stay in input order
+  thrust::detail::temporary_array<KeyType,ExecutionPolicy>   keys(exec, keys_first, n);
+  thrust::detail::temporary_array<ValueType,ExecutionPolicy> values(exec, values_first, n);
+
+  thrust::stable_sort_by_key(exec, keys.begin(), keys.end(), values.begin());
+
+  return thrust::reduce_by_key(exec, keys.begin(), keys.end(), values.begin(), keys_output, values_output, thrust::equal_to<KeyType>(), binary_op);
+} // end reduce_by_key_unsorted()
+
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
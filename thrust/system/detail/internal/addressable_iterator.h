@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file addressable_iterator.h
+ *  \brief Traits for iterators whose elements live in memory.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// true when the iterator's reference is either a reference or one of
+// thrust's wrapped references, so that its elements can be read back after
+// being written and their addresses can be taken
+template<typename Iterator>
+struct has_addressable_reference
+  : thrust::detail::integral_constant<
+      bool,
+      thrust::detail::is_reference<
+        typename thrust::iterator_reference<Iterator>::type
+      >::value ||
+      thrust::detail::is_wrapped_reference<
+        typename thrust::detail::remove_cv<
+          typename thrust::iterator_reference<Iterator>::type
+        >::type
+      >::value
+    >
+{};
+
+
+template<typename Iterator>
+struct is_random_access_iterator
+  : thrust::detail::is_convertible<
+      typename thrust::iterator_traversal<Iterator>::type,
+      thrust::random_access_traversal_tag
+    >
+{};
+
+
+// true when an algorithm may use the iterator as random access scratch space
+template<typename Iterator>
+struct is_addressable_random_access_iterator
+  : thrust::detail::integral_constant<
+      bool,
+      is_random_access_iterator<Iterator>::value &&
+      has_addressable_reference<Iterator>::value
+    >
+{};
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
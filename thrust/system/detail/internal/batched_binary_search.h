@@ -0,0 +1,380 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file batched_binary_search.h
+ *  \brief Vectorized lower_bound, upper_bound and binary_search shared by the
+ *         host parallel systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/addressable_iterator.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace batched_binary_search_detail
+{
+
+
+// the number of tiles of queries is bounded, and tiles are large enough to
+// amortize launching them
+const int max_tiles     = 256;
+const int min_tile_size = 1 << 10;
+
+// the number of unsorted queries searched in lockstep
+const int batch_size = 16;
+
+
+// the element at position i of the table goes before value when
+// lower_bound(value) > i
+struct lower_bound_search
+{
+  template<typename Compare, typename Reference, typename T>
+  static bool goes_before(Compare &comp, const Reference &element, const T &value)
+  {
+    return comp(element, value);
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename Compare, typename T>
+  static Size result(RandomAccessIterator, Size, Compare &, const T &, Size position)
+  {
+    return position;
+  }
+};
+
+
+// the element at position i of the table goes before value when
+// upper_bound(value) > i
+struct upper_bound_search
+{
+  template<typename Compare, typename Reference, typename T>
+  static bool goes_before(Compare &comp, const Reference &element, const T &value)
+  {
+    return !comp(value, element);
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename Compare, typename T>
+  static Size result(RandomAccessIterator, Size, Compare &, const T &, Size position)
+  {
+    return position;
+  }
+};
+
+
+// binary_search finds the lower bound and tests the element there
+struct binary_search_search
+{
+  template<typename Compare, typename Reference, typename T>
+  static bool goes_before(Compare &comp, const Reference &element, const T &value)
+  {
+    return comp(element, value);
+  }
+
+  template<typename RandomAccessIterator, typename Size, typename Compare, typename T>
+  static bool result(RandomAccessIterator table, Size n, Compare &comp, const T &value, Size position)
+  {
+    return position != n && !comp(value, table[position]);
+  }
+};
+
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename Size,
+         typename StrictWeakOrdering,
+         typename Search>
+struct search_tile
+{
+  typedef thrust::detail::wrapped_function<StrictWeakOrdering,bool> Compare;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type T;
+
+  RandomAccessIterator1 table;
+  RandomAccessIterator2 queries;
+  RandomAccessIterator3 output;
+  Size table_size, num_queries, tile_size;
+  StrictWeakOrdering comp;
+
+  // the number of elements of [table + lo, table + hi) which go before value
+  // plus lo
+  Size partition_point(Compare &wrapped_comp, Size lo, Size hi, const T &value) const
+  {
+    while(lo < hi)
+    {
+      const Size mid = lo + (hi - lo) / 2;
+
+      if(Search::goes_before(wrapped_comp, table[mid], value))
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+
+    return lo;
+  }
+
+  // the queries are sorted, so co-iterate them with the table: every search
+  // gallops forward from the previous result. Dense queries thus stream
+  // through the table, while sparse ones cost O(log(distance)) each
+  void search_sorted(Compare &wrapped_comp, Size begin, Size end) const
+  {
+    Size position = partition_point(wrapped_comp, Size(0), table_size, queries[begin]);
+
+    output[begin] = Search::result(table, table_size, wrapped_comp, queries[begin], position);
+
+    for(Size i = begin + 1; i < end; ++i)
+    {
+      const T value = queries[i];
+
+      if(position < table_size && Search::goes_before(wrapped_comp, table[position], value))
+      {
+        // table[position] goes before value, so the result is past position
+        Size step = 1;
+
+        while(step < table_size - position &&
+              Search::goes_before(wrapped_comp, table[position + step], value))
+        {
+          position += step;
+          step *= 2;
+        }
+
+        const Size hi = (step < table_size - position) ? position + step : table_size;
+
+        position = partition_point(wrapped_comp, position + 1, hi, value);
+      }
+
+      output[i] = Search::result(table, table_size, wrapped_comp, value, position);
+    }
+  }
+
+  // searches a batch of queries in lockstep: every step of the searches
+  // issues independent loads, so their cache misses overlap
+  void search_batch(Compare &wrapped_comp, Size begin, int count) const
+  {
+    Size base[batch_size];
+
+    for(int j = 0; j < count; ++j)
+    {
+      base[j] = 0;
+    }
+
+    // branchless binary search, the result is within [base, base + length]
+    for(Size length = table_size; length > 1; length -= length / 2)
+    {
+      const Size half = length / 2;
+
+      for(int j = 0; j < count; ++j)
+      {
+        const T value = queries[begin + j];
+
+        base[j] = Search::goes_before(wrapped_comp, table[base[j] + half], value) ? base[j] + half : base[j];
+      }
+    }
+
+    for(int j = 0; j < count; ++j)
+    {
+      const T value = queries[begin + j];
+
+      const Size position = base[j] + (Search::goes_before(wrapped_comp, table[base[j]], value) ? 1 : 0);
+
+      output[begin + j] = Search::result(table, table_size, wrapped_comp, value, position);
+    }
+  }
+
+  void operator()(Size tile_idx) const
+  {
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (num_queries - begin < tile_size) ? num_queries : begin + tile_size;
+
+    Compare wrapped_comp(comp);
+
+    // the check streams through the tile's queries, which is cheap next to
+    // searching for them
+    bool sorted = true;
+
+    for(Size i = begin + 1; sorted && i < end; ++i)
+    {
+      sorted = !wrapped_comp(queries[i], queries[i - 1]);
+    }
+
+    if(sorted)
+    {
+      search_sorted(wrapped_comp, begin, end);
+      return;
+    }
+
+    Size i = begin;
+
+    for(; end - i >= batch_size; i += batch_size)
+    {
+      search_batch(wrapped_comp, i, batch_size);
+    }
+
+    if(i < end)
+    {
+      search_batch(wrapped_comp, i, static_cast<int>(end - i));
+    }
+  }
+};
+
+
+template<typename Search,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 batched_search(ParallelFor parallel_for,
+                                     RandomAccessIterator1 begin,
+                                     RandomAccessIterator1 end,
+                                     RandomAccessIterator2 values_begin,
+                                     RandomAccessIterator2 values_end,
+                                     RandomAccessIterator3 output,
+                                     StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator2>::type Size;
+
+  const Size num_queries = values_end - values_begin;
+
+  if(num_queries <= 0) return output;
+
+  const Size table_size = end - begin;
+
+  if(table_size == 0)
+  {
+    // every query lands at the front of an empty table
+    for(Size i = 0; i < num_queries; ++i)
+    {
+      output[i] = Search::result(begin, table_size, comp, values_begin[i], Size(0));
+    }
+
+    return output + num_queries;
+  }
+
+  Size num_tiles = (num_queries + min_tile_size - 1) / min_tile_size;
+  num_tiles = (num_tiles < max_tiles) ? num_tiles : Size(max_tiles);
+
+  const Size tile_size = (num_queries + num_tiles - 1) / num_tiles;
+
+  // tile_size is rounded up, so the last tiles may be empty
+  num_tiles = (num_queries + tile_size - 1) / tile_size;
+
+  search_tile<RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,Size,StrictWeakOrdering,Search> search =
+    {begin, values_begin, output, table_size, num_queries, tile_size, comp};
+
+  if(num_tiles == 1)
+  {
+    // don't pay for a parallel launch to search a single tile
+    search(0);
+  }
+  else
+  {
+    parallel_for(num_tiles, search);
+  }
+
+  return output + num_queries;
+}
+
+
+} // end batched_binary_search_detail
+
+
+// true when the batched searches accept the iterators
+template<typename ForwardIterator, typename InputIterator, typename OutputIterator>
+struct use_batched_binary_search
+  : thrust::detail::integral_constant<
+      bool,
+      is_random_access_iterator<ForwardIterator>::value &&
+      is_random_access_iterator<InputIterator>::value &&
+      is_random_access_iterator<OutputIterator>::value
+    >
+{};
+
+
+// Every tile of queries which is sorted according to comp is searched by
+// co-iterating it with the table, and other tiles are searched in batches.
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+template<typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 batched_lower_bound(ParallelFor parallel_for,
+                                          RandomAccessIterator1 begin,
+                                          RandomAccessIterator1 end,
+                                          RandomAccessIterator2 values_begin,
+                                          RandomAccessIterator2 values_end,
+                                          RandomAccessIterator3 output,
+                                          StrictWeakOrdering comp)
+{
+  return batched_binary_search_detail::batched_search<batched_binary_search_detail::lower_bound_search>(
+    parallel_for, begin, end, values_begin, values_end, output, comp);
+}
+
+
+template<typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 batched_upper_bound(ParallelFor parallel_for,
+                                          RandomAccessIterator1 begin,
+                                          RandomAccessIterator1 end,
+                                          RandomAccessIterator2 values_begin,
+                                          RandomAccessIterator2 values_end,
+                                          RandomAccessIterator3 output,
+                                          StrictWeakOrdering comp)
+{
+  return batched_binary_search_detail::batched_search<batched_binary_search_detail::upper_bound_search>(
+    parallel_for, begin, end, values_begin, values_end, output, comp);
+}
+
+
+template<typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename StrictWeakOrdering>
+RandomAccessIterator3 batched_binary_search(ParallelFor parallel_for,
+                                            RandomAccessIterator1 begin,
+                                            RandomAccessIterator1 end,
+                                            RandomAccessIterator2 values_begin,
+                                            RandomAccessIterator2 values_end,
+                                            RandomAccessIterator3 output,
+                                            StrictWeakOrdering comp)
+{
+  return batched_binary_search_detail::batched_search<batched_binary_search_detail::binary_search_search>(
+    parallel_for, begin, end, values_begin, values_end, output, comp);
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
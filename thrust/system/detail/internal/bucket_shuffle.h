@@ -0,0 +1,379 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file bucket_shuffle.h
+ *  \brief Bucketed scatter shuffle shared by the host parallel systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/copy.h>
+#include <thrust/system/detail/internal/addressable_iterator.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace bucket_shuffle_detail
+{
+
+
+inline thrust::detail::uint64_t mix(thrust::detail::uint64_t x)
+{
+  // splitmix64 finalizer
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x;
+}
+
+
+template<typename RandomAccessIterator>
+void iter_swap(RandomAccessIterator a, RandomAccessIterator b)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type T;
+
+  T temp = *a;
+  *a = *b;
+  *b = temp;
+}
+
+
+} // end bucket_shuffle_detail
+
+
+// The bucketed scatter shuffle (Sanders, 1998) sends every element to a
+// uniformly chosen bucket and then shuffles each bucket with Fisher-Yates.
+// Concatenating the buckets yields a uniform permutation. Tiles of the input
+// are scattered independently and buckets are shuffled independently, so
+// every phase is parallel and streams through memory once.
+//
+// Every tile and every bucket draws from its own random stream, keyed by a
+// seed taken from the user's URBG and by the task's index. The tiles and
+// buckets only depend on the size of the input, so the resulting permutation
+// is determined by the URBG state alone and does not depend on the number of
+// threads which executed the tasks.
+class bucket_shuffle_rng
+{
+  public:
+    typedef thrust::detail::uint64_t result_type;
+
+    bucket_shuffle_rng(result_type seed, result_type phase, result_type task)
+      : m_state(bucket_shuffle_detail::mix(seed ^ bucket_shuffle_detail::mix(phase * 0x9e3779b97f4a7c15ull + task)))
+    {}
+
+    result_type operator()()
+    {
+      m_state += 0x9e3779b97f4a7c15ull;
+      return bucket_shuffle_detail::mix(m_state);
+    }
+
+    // returns a uniformly distributed integer in [0, bound)
+    result_type operator()(result_type bound)
+    {
+      // reject the lowest (2^64 mod bound) values to remove modulo bias
+      const result_type threshold = (0 - bound) % bound;
+
+      result_type r = (*this)();
+
+      while(r < threshold)
+      {
+        r = (*this)();
+      }
+
+      return r % bound;
+    }
+
+  private:
+    result_type m_state;
+};
+
+
+// draws the seed of a shuffle from the user's URBG
+template<typename URBG>
+thrust::detail::uint64_t bucket_shuffle_seed(URBG &g)
+{
+  // URBGs may produce fewer than 64 random bits per draw, so fold in a few
+  thrust::detail::uint64_t seed = 0;
+
+  for(int i = 0; i < 4; ++i)
+  {
+    seed = bucket_shuffle_detail::mix(seed ^ static_cast<thrust::detail::uint64_t>(g()));
+  }
+
+  return seed;
+}
+
+
+// the expected number of elements in each bucket
+// a bucket should fit comfortably in a core's private cache
+template<typename T>
+struct bucket_shuffle_default_bucket_size
+{
+  static const thrust::detail::uint64_t bytes = 1 << 18;
+  static const thrust::detail::uint64_t value = (bytes / sizeof(T) > 1024) ? bytes / sizeof(T) : 1024;
+};
+
+
+namespace bucket_shuffle_detail
+{
+
+
+// the number of tiles is bounded so that the table of
+// per-tile bucket counts stays small
+const int max_tiles = 256;
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size>
+struct scatter_tile
+{
+  RandomAccessIterator1 first;
+  RandomAccessIterator2 result;
+  Size *counts;
+  Size n, num_tiles, tile_size, num_buckets;
+  thrust::detail::uint64_t seed;
+  bool count_only;
+
+  void operator()(Size tile_idx) const
+  {
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    // counts are laid out bucket-major so that their exclusive scan gives
+    // every tile its output offset within every bucket
+    Size *my_counts = counts + tile_idx;
+
+    if(count_only)
+    {
+      for(Size b = 0; b < num_buckets; ++b)
+      {
+        my_counts[b * num_tiles] = 0;
+      }
+    }
+
+    // both passes replay the same stream
+    bucket_shuffle_rng rng(seed, 0, tile_idx);
+
+    for(Size i = begin; i < end; ++i)
+    {
+      const Size b = static_cast<Size>(rng(num_buckets));
+
+      if(count_only)
+      {
+        ++my_counts[b * num_tiles];
+      }
+      else
+      {
+        result[my_counts[b * num_tiles]++] = first[i];
+      }
+    }
+  }
+};
+
+
+template<typename RandomAccessIterator, typename Size>
+struct shuffle_bucket
+{
+  RandomAccessIterator result;
+  Size *ends;
+  Size num_tiles;
+  thrust::detail::uint64_t seed;
+
+  void operator()(Size bucket_idx) const
+  {
+    // after the scatter, the offset of a bucket's last tile is the bucket's end
+    const Size begin = (bucket_idx == 0) ? 0 : ends[bucket_idx * num_tiles - 1];
+    const Size end   = ends[(bucket_idx + 1) * num_tiles - 1];
+
+    bucket_shuffle_rng rng(seed, 1, bucket_idx);
+
+    RandomAccessIterator bucket = result + begin;
+
+    for(Size i = end - begin; i > 1; --i)
+    {
+      Size j = static_cast<Size>(rng(i));
+
+      bucket_shuffle_detail::iter_swap(bucket + (i - 1), bucket + j);
+    }
+  }
+};
+
+
+} // end bucket_shuffle_detail
+
+
+// shuffles [first, first + n) into [result, result + n), which must not overlap
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size>
+void bucket_shuffle_scatter(thrust::execution_policy<DerivedPolicy> &exec,
+                            ParallelFor parallel_for,
+                            RandomAccessIterator1 first,
+                            Size n,
+                            RandomAccessIterator2 result,
+                            thrust::detail::uint64_t seed,
+                            Size bucket_size)
+{
+  if(n == 0) return;
+
+  const Size num_buckets = (n + bucket_size - 1) / bucket_size;
+  const Size num_tiles   = (num_buckets < bucket_shuffle_detail::max_tiles) ? num_buckets : Size(bucket_shuffle_detail::max_tiles);
+  const Size tile_size   = (n + num_tiles - 1) / num_tiles;
+
+  thrust::detail::temporary_array<Size, DerivedPolicy> counts(exec, num_tiles * num_buckets);
+
+  Size *counts_ptr = thrust::raw_pointer_cast(&*counts.begin());
+
+  bucket_shuffle_detail::scatter_tile<RandomAccessIterator1,RandomAccessIterator2,Size> scatter =
+    {first, result, counts_ptr, n, num_tiles, tile_size, num_buckets, seed, true};
+
+  // count the elements each tile sends to each bucket
+  parallel_for(num_tiles, scatter);
+
+  // the table is O(sqrt(n)) sized, so scan it sequentially
+  Size sum = 0;
+  for(Size i = 0; i < num_tiles * num_buckets; ++i)
+  {
+    Size count = counts_ptr[i];
+    counts_ptr[i] = sum;
+    sum += count;
+  }
+
+  // scatter every tile into its slots of every bucket
+  scatter.count_only = false;
+  parallel_for(num_tiles, scatter);
+
+  // shuffle every bucket in place
+  bucket_shuffle_detail::shuffle_bucket<RandomAccessIterator2,Size> shuffle =
+    {result, counts_ptr, num_tiles, seed};
+
+  parallel_for(num_buckets, shuffle);
+}
+
+
+namespace bucket_shuffle_detail
+{
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename OutputIterator,
+         typename Size>
+void shuffle_copy(thrust::execution_policy<DerivedPolicy> &exec,
+                  ParallelFor parallel_for,
+                  RandomAccessIterator first,
+                  Size n,
+                  OutputIterator result,
+                  thrust::detail::uint64_t seed,
+                  Size bucket_size,
+                  thrust::detail::true_type) // output is readable
+{
+  bucket_shuffle_scatter(exec, parallel_for, first, n, result, seed, bucket_size);
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename OutputIterator,
+         typename Size>
+void shuffle_copy(thrust::execution_policy<DerivedPolicy> &exec,
+                  ParallelFor parallel_for,
+                  RandomAccessIterator first,
+                  Size n,
+                  OutputIterator result,
+                  thrust::detail::uint64_t seed,
+                  Size bucket_size,
+                  thrust::detail::false_type) // output is write-only
+{
+  // shuffle into a temporary and copy it out, so that the permutation is the
+  // same as that of shuffle_copy into a readable output
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  thrust::detail::temporary_array<value_type, DerivedPolicy> temp(exec, n);
+
+  bucket_shuffle_scatter(exec, parallel_for, first, n, temp.begin(), seed, bucket_size);
+
+  thrust::copy(exec, temp.begin(), temp.end(), result);
+}
+
+
+} // end bucket_shuffle_detail
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename OutputIterator,
+         typename URBG>
+void bucket_shuffle_copy(thrust::execution_policy<DerivedPolicy> &exec,
+                         ParallelFor parallel_for,
+                         RandomAccessIterator first,
+                         RandomAccessIterator last,
+                         OutputIterator result,
+                         URBG &g,
+                         typename thrust::iterator_difference<RandomAccessIterator>::type bucket_size)
+{
+  const thrust::detail::uint64_t seed = bucket_shuffle_seed(g);
+
+  bucket_shuffle_detail::shuffle_copy(exec, parallel_for, first, last - first, result, seed, bucket_size,
+    is_addressable_random_access_iterator<OutputIterator>());
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename URBG>
+void bucket_shuffle(thrust::execution_policy<DerivedPolicy> &exec,
+                    ParallelFor parallel_for,
+                    RandomAccessIterator first,
+                    RandomAccessIterator last,
+                    URBG &g,
+                    typename thrust::iterator_difference<RandomAccessIterator>::type bucket_size)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  const thrust::detail::uint64_t seed = bucket_shuffle_seed(g);
+
+  // the scatter cannot happen in place, so shuffle from a copy of the input
+  thrust::detail::temporary_array<value_type, DerivedPolicy> temp(exec, first, last);
+
+  bucket_shuffle_scatter(exec, parallel_for, temp.begin(), last - first, first, seed, bucket_size);
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,192 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file early_exit_find.h
+ *  \brief Parallel find_if which stops as soon as an earlier match is known,
+ *         shared by the host parallel systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <atomic>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace early_exit_find_detail
+{
+
+
+// the number of workers is bounded, but should exceed the number of threads
+const int max_workers = 256;
+
+// the number of bytes each worker claims at a time
+const int block_bytes = 1 << 14;
+
+
+// the predicate is evaluated over this many elements before its results are
+// tested, so that the loop has no early exit the compiler would need to
+// preserve and can be vectorized
+const int chunk_size = 32;
+
+
+template<typename Size>
+struct find_state
+{
+  // the index of the next block to claim
+  std::atomic<Size> next_block;
+
+  // the smallest index of a match found so far
+  std::atomic<Size> result;
+};
+
+
+template<typename RandomAccessIterator, typename Size, typename Predicate>
+Size find_in_block(RandomAccessIterator first, Size begin, Size end, Predicate pred)
+{
+  Size i = begin;
+
+  for(; end - i >= chunk_size; i += chunk_size)
+  {
+    bool found = false;
+
+    for(int j = 0; j < chunk_size; ++j)
+    {
+      found |= static_cast<bool>(pred(first[i + j]));
+    }
+
+    if(found) break;
+  }
+
+  // find the match within the chunk, or search the remainder of the block
+  for(; i < end; ++i)
+  {
+    if(pred(first[i])) return i;
+  }
+
+  return end;
+}
+
+
+template<typename RandomAccessIterator, typename Size, typename Predicate>
+struct find_worker
+{
+  RandomAccessIterator first;
+  Predicate pred;
+  Size n, block_size, num_blocks;
+  find_state<Size> *state;
+
+  template<typename Index>
+  void operator()(Index) const
+  {
+    thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+    for(;;)
+    {
+      // workers claim blocks in order, so once a block begins after a known
+      // match, so do all blocks claimed later
+      const Size block = state->next_block.fetch_add(1, std::memory_order_relaxed);
+
+      if(block >= num_blocks) return;
+
+      const Size begin = block * block_size;
+
+      if(begin >= state->result.load(std::memory_order_relaxed)) return;
+
+      const Size end = (n - begin < block_size) ? n : begin + block_size;
+
+      const Size found = find_in_block(first, begin, end, wrapped_pred);
+
+      if(found < end)
+      {
+        Size current = state->result.load(std::memory_order_relaxed);
+
+        while(found < current &&
+              !state->result.compare_exchange_weak(current, found, std::memory_order_relaxed))
+        {}
+
+        return;
+      }
+    }
+  }
+};
+
+
+} // end early_exit_find_detail
+
+
+// returns the first iterator i in [first, last) for which pred(*i) is true,
+// or last if there is none
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+template<typename ParallelFor,
+         typename RandomAccessIterator,
+         typename Predicate>
+RandomAccessIterator early_exit_find_if(ParallelFor parallel_for,
+                                        RandomAccessIterator first,
+                                        RandomAccessIterator last,
+                                        Predicate pred)
+{
+  namespace ns = early_exit_find_detail;
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type Size;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      T;
+
+  const Size n = last - first;
+
+  if(n <= 0) return last;
+
+  const Size block_size  = (sizeof(T) < ns::block_bytes / ns::chunk_size) ? Size(ns::block_bytes / sizeof(T)) : Size(ns::chunk_size);
+  const Size num_blocks  = (n + block_size - 1) / block_size;
+  const Size num_workers = (num_blocks < ns::max_workers) ? num_blocks : Size(ns::max_workers);
+
+  ns::find_state<Size> state;
+  state.next_block = 0;
+  state.result     = n;
+
+  ns::find_worker<RandomAccessIterator,Size,Predicate> worker =
+    {first, pred, n, block_size, num_blocks, &state};
+
+  if(num_workers == 1)
+  {
+    // don't pay for a parallel launch to search a single block
+    worker(0);
+  }
+  else
+  {
+    parallel_for(num_workers, worker);
+  }
+
+  return first + state.result.load();
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
+#endif // THRUST_CPP_DIALECT >= 2011
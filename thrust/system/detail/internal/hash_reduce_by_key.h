@@ -0,0 +1,342 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file hash_reduce_by_key.h
+ *  \brief Hash based reduce_by_key_unsorted shared by the host parallel
+ *         systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/arithmetic_hash.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/pair.h>
+#include <thrust/system/detail/generic/reduce_by_key.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace hash_reduce_by_key_detail
+{
+
+
+// the number of tiles is bounded so that their tables can be merged
+// sequentially, and tiles are large enough to amortize launching them
+const int max_tiles     = 256;
+const int min_tile_size = 1 << 14;
+
+// the tables of the tiles are small enough to stay in cache. A tile whose
+// table fills past half of its slots gives up, and the reduction falls back
+// to sorting
+const int max_table_size = 1 << 12;
+
+
+template<typename Size>
+struct tile_status
+{
+  // the number of distinct keys of the tile
+  Size count;
+
+  // whether the tile has more distinct keys than its table holds
+  bool overflow;
+};
+
+
+// every tile reduces its values into its own table, and records the slots
+// of its keys in the order of their first occurrence
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Key,
+         typename Value,
+         typename Size,
+         typename BinaryFunction>
+struct aggregate_tiles
+{
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 values;
+  Key *table_keys;
+  Value *table_values;
+  unsigned char *occupied;
+  Size *order;
+  tile_status<Size> *status;
+  Size n, tile_size, table_size;
+  BinaryFunction binary_op;
+
+  void operator()(Size tile_idx) const
+  {
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    Key *tile_keys               = table_keys   + tile_idx * table_size;
+    Value *tile_values           = table_values + tile_idx * table_size;
+    unsigned char *tile_occupied = occupied     + tile_idx * table_size;
+    Size *tile_order             = order        + tile_idx * (table_size / 2);
+
+    const Size mask      = table_size - 1;
+    const Size max_count = table_size / 2;
+
+    for(Size i = 0; i < table_size; ++i)
+    {
+      tile_occupied[i] = 0;
+    }
+
+    thrust::detail::arithmetic_hash<Key> hash;
+
+    BinaryFunction op = binary_op;
+
+    Size count = 0;
+
+    for(Size i = begin; i < end; ++i)
+    {
+      const Key key = keys[i];
+
+      Size slot = static_cast<Size>(hash(key) & mask);
+
+      while(tile_occupied[slot] && !(tile_keys[slot] == key))
+      {
+        slot = (slot + 1) & mask;
+      }
+
+      if(tile_occupied[slot])
+      {
+        tile_values[slot] = op(tile_values[slot], values[i]);
+      }
+      else
+      {
+        if(count == max_count)
+        {
+          status[tile_idx].overflow = true;
+          return;
+        }
+
+        tile_occupied[slot] = 1;
+        tile_keys[slot]     = key;
+        tile_values[slot]   = values[i];
+        tile_order[count++] = slot;
+      }
+    }
+
+    status[tile_idx].count    = count;
+    status[tile_idx].overflow = false;
+  }
+};
+
+
+// the smallest power of two table which holds all the keys of a tile, up to
+// max_table_size
+template<typename Size>
+Size table_size_for(Size tile_size)
+{
+  Size result = 2;
+
+  while(result < max_table_size && result < 2 * tile_size)
+  {
+    result *= 2;
+  }
+
+  return result;
+}
+
+
+} // end hash_reduce_by_key_detail
+
+
+// true when hash_reduce_by_key accepts the iterators
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator1, typename OutputIterator2>
+struct use_hash_reduce_by_key
+  : thrust::detail::integral_constant<
+      bool,
+      is_random_access_iterator<InputIterator1>::value &&
+      is_random_access_iterator<InputIterator2>::value &&
+      is_random_access_iterator<OutputIterator1>::value &&
+      is_random_access_iterator<OutputIterator2>::value &&
+      thrust::detail::is_arithmetic<typename thrust::iterator_value<InputIterator1>::type>::value
+    >
+{};
+
+
+// Every tile reduces its values into a small open addressing table of its
+// own, in parallel. The tables are then merged in order into a table of all
+// the distinct keys, so the values of every key are reduced in the order
+// they appear in the input, and the keys are output in the order of their
+// first occurrence. When a tile has too many distinct keys for its table,
+// sorting is faster, and the reduction falls back to
+// generic::reduce_by_key_unsorted.
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename BinaryFunction>
+thrust::pair<RandomAccessIterator3,RandomAccessIterator4>
+  hash_reduce_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                     ParallelFor parallel_for,
+                     RandomAccessIterator1 keys_first,
+                     RandomAccessIterator1 keys_last,
+                     RandomAccessIterator2 values_first,
+                     RandomAccessIterator3 keys_output,
+                     RandomAccessIterator4 values_output,
+                     BinaryFunction binary_op)
+{
+  namespace ns = hash_reduce_by_key_detail;
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      Key;
+
+  // use the input type as the intermediate type of the reduction, like
+  // generic::reduce_by_key
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      Value;
+
+  const Size n = keys_last - keys_first;
+
+  if(n <= 0) return thrust::make_pair(keys_output, values_output);
+
+  Size num_tiles = (n + ns::min_tile_size - 1) / ns::min_tile_size;
+  num_tiles = (num_tiles < ns::max_tiles) ? num_tiles : Size(ns::max_tiles);
+
+  const Size tile_size = (n + num_tiles - 1) / num_tiles;
+
+  // tile_size is rounded up, so the last tiles may be empty
+  num_tiles = (n + tile_size - 1) / tile_size;
+
+  const Size table_size = ns::table_size_for(tile_size);
+
+  thrust::detail::temporary_array<Key, DerivedPolicy>           table_keys(0, exec, num_tiles * table_size);
+  thrust::detail::temporary_array<Value, DerivedPolicy>         table_values(exec, num_tiles * table_size);
+  thrust::detail::temporary_array<unsigned char, DerivedPolicy> occupied(0, exec, num_tiles * table_size);
+  thrust::detail::temporary_array<Size, DerivedPolicy>          order(0, exec, num_tiles * (table_size / 2));
+  thrust::detail::temporary_array<ns::tile_status<Size>, DerivedPolicy> status(exec, num_tiles);
+
+  Key *table_keys_ptr                = thrust::raw_pointer_cast(&*table_keys.begin());
+  Value *table_values_ptr            = thrust::raw_pointer_cast(&*table_values.begin());
+  ns::tile_status<Size> *status_ptr  = thrust::raw_pointer_cast(&*status.begin());
+
+  ns::aggregate_tiles<RandomAccessIterator1,RandomAccessIterator2,Key,Value,Size,BinaryFunction> aggregate =
+    {keys_first, values_first, table_keys_ptr, table_values_ptr,
+     thrust::raw_pointer_cast(&*occupied.begin()), thrust::raw_pointer_cast(&*order.begin()),
+     status_ptr, n, tile_size, table_size, binary_op};
+
+  if(num_tiles == 1)
+  {
+    // don't pay for a parallel launch to aggregate a single tile
+    aggregate(0);
+  }
+  else
+  {
+    parallel_for(num_tiles, aggregate);
+  }
+
+  Size total = 0;
+
+  for(Size i = 0; i < num_tiles; ++i)
+  {
+    if(status_ptr[i].overflow)
+    {
+      return thrust::system::detail::generic::reduce_by_key_unsorted(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_op);
+    }
+
+    total += status_ptr[i].count;
+  }
+
+  // merge the tables in order into a table of the distinct keys, whose slots
+  // hold the positions of the keys in the merged keys and values
+  Size merged_table_size = 2;
+
+  while(merged_table_size < 2 * total)
+  {
+    merged_table_size *= 2;
+  }
+
+  const Size mask = merged_table_size - 1;
+
+  thrust::detail::temporary_array<Size, DerivedPolicy>  merged_table(0, exec, merged_table_size);
+  thrust::detail::temporary_array<Key, DerivedPolicy>   merged_keys(0, exec, total);
+  thrust::detail::temporary_array<Value, DerivedPolicy> merged_values(exec, total);
+
+  Size *merged_table_ptr   = thrust::raw_pointer_cast(&*merged_table.begin());
+  Key *merged_keys_ptr     = thrust::raw_pointer_cast(&*merged_keys.begin());
+  Value *merged_values_ptr = thrust::raw_pointer_cast(&*merged_values.begin());
+
+  for(Size i = 0; i < merged_table_size; ++i)
+  {
+    merged_table_ptr[i] = -1;
+  }
+
+  thrust::detail::arithmetic_hash<Key> hash;
+
+  const Size *order_ptr = thrust::raw_pointer_cast(&*order.begin());
+
+  Size result_size = 0;
+
+  for(Size i = 0; i < num_tiles; ++i)
+  {
+    const Key *tile_keys     = table_keys_ptr   + i * table_size;
+    const Value *tile_values = table_values_ptr + i * table_size;
+    const Size *tile_order   = order_ptr        + i * (table_size / 2);
+
+    for(Size j = 0; j < status_ptr[i].count; ++j)
+    {
+      const Key key = tile_keys[tile_order[j]];
+
+      Size slot = static_cast<Size>(hash(key) & mask);
+
+      while(merged_table_ptr[slot] != -1 && !(merged_keys_ptr[merged_table_ptr[slot]] == key))
+      {
+        slot = (slot + 1) & mask;
+      }
+
+      if(merged_table_ptr[slot] == -1)
+      {
+        merged_table_ptr[slot] = result_size;
+
+        merged_keys_ptr[result_size]   = key;
+        merged_values_ptr[result_size] = tile_values[tile_order[j]];
+
+        ++result_size;
+      }
+      else
+      {
+        Value &value = merged_values_ptr[merged_table_ptr[slot]];
+
+        value = binary_op(value, tile_values[tile_order[j]]);
+      }
+    }
+  }
+
+  for(Size i = 0; i < result_size; ++i)
+  {
+    keys_output[i]   = merged_keys_ptr[i];
+    values_output[i] = merged_values_ptr[i];
+  }
+
+  return thrust::make_pair(keys_output + result_size, values_output + result_size);
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
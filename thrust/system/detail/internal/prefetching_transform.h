@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file prefetching_transform.h
+ *  \brief Transform loop which software prefetches the targets of
+ *         permutation_iterators, used by the host systems for gather,
+ *         scatter and transforms through permutation_iterator.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/system/detail/internal/addressable_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/permutation_iterator.h>
+
+// THRUST_PREFETCH_DISTANCE is the number of elements ahead of the current
+// position whose permuted targets are prefetched. Define it to 0 before
+// including thrust to disable software prefetching.
+#ifndef THRUST_PREFETCH_DISTANCE
+#define THRUST_PREFETCH_DISTANCE 32
+#endif
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace prefetching_transform_detail
+{
+
+
+// an iterator is worth prefetching when it visits its elements in an order
+// the hardware prefetcher cannot predict, i.e. when it is a permutation_iterator
+template<typename Iterator>
+struct is_prefetchable
+  : thrust::detail::false_type
+{};
+
+// prefetching dereferences the index iterator ahead of the loop, so its
+// indices must be read from memory: an index computed by a functor (e.g. a
+// transform_iterator) may have side effects which must happen exactly once
+template<typename ElementIterator, typename IndexIterator>
+struct is_prefetchable<thrust::permutation_iterator<ElementIterator,IndexIterator> >
+  : thrust::detail::integral_constant<
+      bool,
+      is_addressable_random_access_iterator<thrust::permutation_iterator<ElementIterator,IndexIterator> >::value &&
+      has_addressable_reference<IndexIterator>::value
+    >
+{};
+
+
+struct read_access {};
+struct write_access {};
+
+
+__host__ __device__
+inline void prefetch(const void *ptr, read_access)
+{
+  if (THRUST_IS_HOST_CODE) {
+    #if THRUST_INCLUDE_HOST_CODE
+      #if (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_GCC) || (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_CLANG)
+        __builtin_prefetch(ptr, 0, 1);
+      #else
+        (void) ptr;
+      #endif
+    #endif
+  }
+}
+
+
+__host__ __device__
+inline void prefetch(const void *ptr, write_access)
+{
+  if (THRUST_IS_HOST_CODE) {
+    #if THRUST_INCLUDE_HOST_CODE
+      #if (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_GCC) || (THRUST_HOST_COMPILER == THRUST_HOST_COMPILER_CLANG)
+        __builtin_prefetch(ptr, 1, 1);
+      #else
+        (void) ptr;
+      #endif
+    #endif
+  }
+}
+
+
+__thrust_exec_check_disable__
+template<typename Iterator, typename Access>
+__host__ __device__
+void prefetch_element(Iterator, Access, thrust::detail::false_type)
+{
+}
+
+
+__thrust_exec_check_disable__
+template<typename Iterator, typename Access>
+__host__ __device__
+void prefetch_element(Iterator iter, Access access, thrust::detail::true_type)
+{
+  // computing the address only reads the index, not the element itself
+  prefetch(&thrust::raw_reference_cast(*iter), access);
+}
+
+
+} // end prefetching_transform_detail
+
+
+// true when a transform from InputIterator to OutputIterator should use
+// transform_prefetching_range
+template<typename InputIterator, typename OutputIterator>
+struct use_prefetching_transform
+  : thrust::detail::integral_constant<
+      bool,
+      (THRUST_PREFETCH_DISTANCE > 0) &&
+      is_random_access_iterator<InputIterator>::value &&
+      is_random_access_iterator<OutputIterator>::value &&
+      (prefetching_transform_detail::is_prefetchable<InputIterator>::value ||
+       prefetching_transform_detail::is_prefetchable<OutputIterator>::value)
+    >
+{};
+
+
+// performs result[i] = op(first[i]) for i in [begin, end), prefetching the
+// element THRUST_PREFETCH_DISTANCE positions ahead through whichever of first
+// and result is a permutation_iterator. The prefetches never cross end, so a
+// parallel system may call this on disjoint subranges concurrently.
+__thrust_exec_check_disable__
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Size,
+         typename UnaryFunction>
+__host__ __device__
+void transform_prefetching_range(InputIterator first,
+                                 OutputIterator result,
+                                 Size begin,
+                                 Size end,
+                                 UnaryFunction op)
+{
+  namespace ns = prefetching_transform_detail;
+
+  typename ns::is_prefetchable<InputIterator>::type  prefetch_input;
+  typename ns::is_prefetchable<OutputIterator>::type prefetch_output;
+
+  const Size distance = THRUST_PREFETCH_DISTANCE;
+
+  InputIterator  in  = first  + begin;
+  OutputIterator out = result + begin;
+
+  Size i = begin;
+
+  // the main loop prefetches distance elements ahead
+  for(; end - i > distance; ++i, ++in, ++out)
+  {
+    ns::prefetch_element(in  + distance, ns::read_access(),  prefetch_input);
+    ns::prefetch_element(out + distance, ns::write_access(), prefetch_output);
+
+    *out = op(*in);
+  }
+
+  // the remaining elements have already been prefetched
+  for(; i < end; ++i, ++in, ++out)
+  {
+    *out = op(*in);
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,230 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file privatized_histogram.h
+ *  \brief Histograms with privatized bins shared by the host parallel
+ *         systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/addressable_iterator.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace privatized_histogram_detail
+{
+
+
+// the number of tiles is bounded so that the bins of the tiles stay small
+// next to the input, and tiles are large enough to amortize launching them
+const int max_tiles     = 256;
+const int min_tile_size = 1 << 14;
+
+// the bins of the samples of a tile are computed this many at a time,
+// before any of them is counted
+const int chunk_size = 256;
+
+// the bins are summed over the tiles in blocks of this many bins
+const int merge_block_size = 1 << 12;
+
+
+// every tile counts its samples into bins of its own. The last of its
+// num_bins + 1 bins counts the samples outside of the histogram, so that
+// counting needs no branch
+template<typename RandomAccessIterator, typename Bins, typename Counter, typename Size, typename BinSize>
+struct count_tiles
+{
+  RandomAccessIterator first;
+  Bins bins;
+  Counter *counts;
+  Size n, tile_size;
+  BinSize num_bins;
+
+  void operator()(Size tile_idx) const
+  {
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    Counter *tile_counts = counts + tile_idx * (num_bins + 1);
+
+    for(BinSize i = 0; i <= num_bins; ++i)
+    {
+      tile_counts[i] = Counter(0);
+    }
+
+    // the bins of a chunk don't depend on each other, so their loop may
+    // be vectorized
+    BinSize chunk_bins[chunk_size];
+
+    for(Size i = begin; i < end; i += chunk_size)
+    {
+      const Size size = (end - i < Size(chunk_size)) ? end - i : Size(chunk_size);
+
+      for(Size j = 0; j < size; ++j)
+      {
+        chunk_bins[j] = bins(first[i + j]);
+      }
+
+      for(Size j = 0; j < size; ++j)
+      {
+        tile_counts[chunk_bins[j]] += Counter(1);
+      }
+    }
+  }
+};
+
+
+// sums a block of bins over the tiles into the histogram
+template<typename Counter, typename RandomAccessIterator, typename Size>
+struct merge_tiles
+{
+  const Counter *counts;
+  RandomAccessIterator histogram;
+  Size num_tiles, num_bins;
+
+  void operator()(Size block_idx) const
+  {
+    const Size begin = block_idx * Size(merge_block_size);
+    const Size end   = (num_bins - begin < Size(merge_block_size)) ? num_bins : begin + Size(merge_block_size);
+
+    for(Size bin = begin; bin < end; ++bin)
+    {
+      Counter sum = counts[bin];
+
+      for(Size tile_idx = 1; tile_idx < num_tiles; ++tile_idx)
+      {
+        sum += counts[tile_idx * (num_bins + 1) + bin];
+      }
+
+      histogram[bin] = sum;
+    }
+  }
+};
+
+
+} // end privatized_histogram_detail
+
+
+// true when privatized_histogram accepts the iterators
+template<typename InputIterator, typename OutputIterator>
+struct use_privatized_histogram
+  : thrust::detail::integral_constant<
+      bool,
+      is_random_access_iterator<InputIterator>::value &&
+      is_random_access_iterator<OutputIterator>::value &&
+      thrust::detail::is_arithmetic<typename thrust::iterator_value<OutputIterator>::type>::value
+    >
+{};
+
+
+// Every tile of the input counts its samples into private bins, in
+// parallel, and the bins of the tiles are then summed into the histogram,
+// in parallel over blocks of bins. Samples are neither copied nor sorted,
+// so the histogram costs a single pass over the input. The number of tiles
+// is limited so that summing their bins costs less than counting the
+// samples.
+// bins(x) must return the bin of the sample x in [0, num_bins), or num_bins
+// when x falls outside of the histogram.
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Bins,
+         typename BinSize>
+RandomAccessIterator2 privatized_histogram(thrust::execution_policy<DerivedPolicy> &exec,
+                                           ParallelFor parallel_for,
+                                           RandomAccessIterator1 first,
+                                           RandomAccessIterator1 last,
+                                           RandomAccessIterator2 histogram,
+                                           Bins bins,
+                                           BinSize num_bins)
+{
+  namespace ns = privatized_histogram_detail;
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      Counter;
+
+  if(num_bins <= 0) return histogram;
+
+  const Size n = last - first;
+
+  // the number of bins of every tile, including the bin of the samples
+  // outside of the histogram
+  const Size num_tile_bins = static_cast<Size>(num_bins) + 1;
+
+  Size num_tiles = (n + ns::min_tile_size - 1) / ns::min_tile_size;
+  num_tiles = (num_tiles < Size(ns::max_tiles)) ? num_tiles : Size(ns::max_tiles);
+
+  // the bins of every tile are summed, so tiles have more samples than bins
+  const Size max_tiles_for_bins = n / num_tile_bins;
+  num_tiles = (num_tiles < max_tiles_for_bins) ? num_tiles : max_tiles_for_bins;
+  num_tiles = (num_tiles < 1) ? Size(1) : num_tiles;
+
+  const Size tile_size = (n + num_tiles - 1) / num_tiles;
+
+  // tile_size is rounded up, so the last tiles may be empty
+  num_tiles = (n == 0) ? Size(1) : (n + tile_size - 1) / tile_size;
+
+  thrust::detail::temporary_array<Counter,DerivedPolicy> counts(0, exec, num_tiles * num_tile_bins);
+
+  Counter *counts_ptr = thrust::raw_pointer_cast(&*counts.begin());
+
+  const ns::count_tiles<RandomAccessIterator1,Bins,Counter,Size,BinSize> count = {first, bins, counts_ptr, n, tile_size, num_bins};
+
+  if(num_tiles == 1)
+  {
+    // don't pay for a parallel launch to count a single tile
+    count(0);
+  }
+  else
+  {
+    parallel_for(num_tiles, count);
+  }
+
+  const ns::merge_tiles<Counter,RandomAccessIterator2,Size> merge = {counts_ptr, histogram, num_tiles, num_tile_bins - 1};
+
+  const Size num_blocks = (num_tile_bins - 1 + Size(ns::merge_block_size) - 1) / Size(ns::merge_block_size);
+
+  if(num_blocks == 1)
+  {
+    merge(0);
+  }
+  else
+  {
+    parallel_for(num_blocks, merge);
+  }
+
+  return histogram + num_bins;
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,559 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file tiled_extrema.h
+ *  \brief min_element, max_element and minmax_element shared by the host
+ *         parallel systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/functional.h>
+#include <thrust/extrema.h>
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <limits>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace tiled_extrema_detail
+{
+
+
+// the number of tiles is bounded so that the per-tile results can be
+// combined sequentially, and tiles are large enough to amortize a task
+const int max_tiles     = 256;
+const int min_tile_size = 1 << 12;
+
+
+// comparators which order arithmetic values like operator< or operator>
+struct no_value_order {};
+struct less_value_order {};
+struct greater_value_order {};
+
+template<typename Compare, typename T>
+struct value_order_impl { typedef no_value_order type; };
+
+template<typename T>
+struct value_order_impl<thrust::less<T>, T> { typedef less_value_order type; };
+template<typename T>
+struct value_order_impl<thrust::less<void>, T> { typedef less_value_order type; };
+template<typename T>
+struct value_order_impl<std::less<T>, T> { typedef less_value_order type; };
+template<typename T>
+struct value_order_impl<thrust::greater<T>, T> { typedef greater_value_order type; };
+template<typename T>
+struct value_order_impl<thrust::greater<void>, T> { typedef greater_value_order type; };
+template<typename T>
+struct value_order_impl<std::greater<T>, T> { typedef greater_value_order type; };
+
+template<typename Compare, typename T>
+struct value_order
+  : thrust::detail::eval_if<
+      thrust::detail::is_arithmetic<T>::value,
+      value_order_impl<Compare,T>,
+      thrust::detail::identity_<no_value_order>
+    >
+{};
+
+
+template<typename T>
+T greatest_value(thrust::detail::true_type /* has infinity */)
+{
+  return std::numeric_limits<T>::infinity();
+}
+
+template<typename T>
+T greatest_value(thrust::detail::false_type)
+{
+  return std::numeric_limits<T>::max();
+}
+
+template<typename T>
+T least_value(thrust::detail::true_type /* has infinity */)
+{
+  return -std::numeric_limits<T>::infinity();
+}
+
+template<typename T>
+T least_value(thrust::detail::false_type)
+{
+  return std::numeric_limits<T>::min();
+}
+
+
+// these mirror the sequential loops, which replace the running extremum only
+// when an element compares strictly less (or greater). A NaN never does, and
+// starting from an infinity keeps NaNs out of the running extremum
+template<typename T>
+struct min_value
+{
+  static T identity()
+  {
+    return greatest_value<T>(thrust::detail::integral_constant<bool, std::numeric_limits<T>::has_infinity>());
+  }
+
+  T operator()(T acc, T x) const
+  {
+    return x < acc ? x : acc;
+  }
+};
+
+template<typename T>
+struct max_value
+{
+  static T identity()
+  {
+    return least_value<T>(thrust::detail::integral_constant<bool, std::numeric_limits<T>::has_infinity>());
+  }
+
+  T operator()(T acc, T x) const
+  {
+    return acc < x ? x : acc;
+  }
+};
+
+// stands in for an extremum which is not needed
+template<typename T>
+struct no_value
+{
+  static T identity()
+  {
+    return T();
+  }
+
+  T operator()(T acc, T) const
+  {
+    return acc;
+  }
+};
+
+
+// finds the extrema of [first, first + n) in independent lanes, which lets
+// the compiler keep them in vector registers
+template<typename Iterator, typename Size, typename T, typename MinOp, typename MaxOp>
+void reduce_values(Iterator first, Size n, MinOp min_op, MaxOp max_op, T &min_result, T &max_result)
+{
+  const int lanes = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+  T min_lanes[lanes];
+  T max_lanes[lanes];
+
+  for(int j = 0; j < lanes; ++j)
+  {
+    min_lanes[j] = min_result;
+    max_lanes[j] = max_result;
+  }
+
+  Size i = 0;
+
+  for(; n - i >= lanes; i += lanes)
+  {
+    for(int j = 0; j < lanes; ++j)
+    {
+      T x = first[i + j];
+      min_lanes[j] = min_op(min_lanes[j], x);
+      max_lanes[j] = max_op(max_lanes[j], x);
+    }
+  }
+
+  for(; i < n; ++i)
+  {
+    T x = first[i];
+    min_result = min_op(min_result, x);
+    max_result = max_op(max_result, x);
+  }
+
+  for(int j = 0; j < lanes; ++j)
+  {
+    min_result = min_op(min_result, min_lanes[j]);
+    max_result = max_op(max_result, max_lanes[j]);
+  }
+}
+
+
+template<typename Iterator, typename Size, typename T, typename MinOp, typename MaxOp>
+struct reduce_tile_values
+{
+  Iterator first;
+  Size n, tile_size;
+  T *min_results, *max_results;
+  MinOp min_op;
+  MaxOp max_op;
+
+  void operator()(Size tile) const
+  {
+    const Size begin = tile * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    T min_result = MinOp::identity();
+    T max_result = MaxOp::identity();
+
+    reduce_values(first + begin, end - begin, min_op, max_op, min_result, max_result);
+
+    min_results[tile] = min_result;
+    max_results[tile] = max_result;
+  }
+};
+
+
+template<typename RandomAccessIterator, typename Size, typename BinaryPredicate>
+struct tile_extrema
+{
+  RandomAccessIterator first;
+  Size n, tile_size;
+  Size *min_results, *max_results;
+  BinaryPredicate comp;
+  bool find_min, find_max;
+
+  void operator()(Size tile) const
+  {
+    const Size begin = tile * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    if(find_min && find_max)
+    {
+      thrust::pair<RandomAccessIterator,RandomAccessIterator> result =
+        thrust::minmax_element(thrust::system::detail::sequential::seq, first + begin, first + end, comp);
+
+      min_results[tile] = result.first  - first;
+      max_results[tile] = result.second - first;
+    }
+    else if(find_min)
+    {
+      min_results[tile] = thrust::min_element(thrust::system::detail::sequential::seq, first + begin, first + end, comp) - first;
+    }
+    else
+    {
+      max_results[tile] = thrust::max_element(thrust::system::detail::sequential::seq, first + begin, first + end, comp) - first;
+    }
+  }
+};
+
+
+// returns the index of the first element of [first, first + n) at or after
+// begin which equals value
+template<typename Iterator, typename Size, typename T>
+Size find_value(Iterator first, Size begin, Size n, T value)
+{
+  for(Size i = begin; i < n; ++i)
+  {
+    if(T(first[i]) == value) return i;
+  }
+
+  // unreachable: value is the extremum of a range which holds it
+  return 0;
+}
+
+
+template<typename Iterator, typename Size, typename T, typename Op>
+Size locate(Iterator first, Size n, Size tile_size, const T *results, Size num_tiles, Op op)
+{
+  T value = Op::identity();
+
+  for(Size tile = 0; tile < num_tiles; ++tile)
+  {
+    value = op(value, results[tile]);
+  }
+
+  // tiles before the first one which holds value can not hold it
+  Size tile = 0;
+  while(tile + 1 < num_tiles && !(results[tile] == value)) ++tile;
+
+  return find_value(first, tile * tile_size, n, value);
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename Iterator,
+         typename Size,
+         typename MinOp,
+         typename MaxOp>
+thrust::pair<Size,Size>
+  value_extrema(thrust::execution_policy<DerivedPolicy> &exec,
+                ParallelFor parallel_for,
+                Iterator first,
+                Size n,
+                Size num_tiles,
+                Size tile_size,
+                MinOp min_op,
+                MaxOp max_op,
+                bool find_min,
+                bool find_max)
+{
+  typedef typename thrust::iterator_value<Iterator>::type T;
+
+  // a leading NaN compares neither less nor greater than anything,
+  // so the sequential loop would never replace it
+  T x = first[0];
+  if(!(x == x)) return thrust::make_pair(Size(0), Size(0));
+
+  thrust::detail::temporary_array<T, DerivedPolicy> results(exec, 2 * num_tiles);
+
+  T *min_results = thrust::raw_pointer_cast(&*results.begin());
+  T *max_results = min_results + num_tiles;
+
+  reduce_tile_values<Iterator,Size,T,MinOp,MaxOp> reduce =
+    {first, n, tile_size, min_results, max_results, min_op, max_op};
+
+  parallel_for(num_tiles, reduce);
+
+  Size imin = find_min ? locate(first, n, tile_size, min_results, num_tiles, min_op) : Size(0);
+  Size imax = find_max ? locate(first, n, tile_size, max_results, num_tiles, max_op) : Size(0);
+
+  return thrust::make_pair(imin, imax);
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename Size,
+         typename BinaryPredicate>
+thrust::pair<Size,Size>
+  extrema(thrust::execution_policy<DerivedPolicy> &exec,
+          ParallelFor parallel_for,
+          RandomAccessIterator first,
+          Size n,
+          Size num_tiles,
+          Size tile_size,
+          BinaryPredicate comp,
+          bool find_min,
+          bool find_max,
+          no_value_order)
+{
+  thrust::detail::temporary_array<Size, DerivedPolicy> results(exec, 2 * num_tiles);
+
+  Size *min_results = thrust::raw_pointer_cast(&*results.begin());
+  Size *max_results = min_results + num_tiles;
+
+  tile_extrema<RandomAccessIterator,Size,BinaryPredicate> reduce =
+    {first, n, tile_size, min_results, max_results, comp, find_min, find_max};
+
+  parallel_for(num_tiles, reduce);
+
+  // combine the tiles in order, so that the first of equivalent extrema wins
+  Size imin = 0;
+  Size imax = 0;
+
+  if(find_min)
+  {
+    imin = min_results[0];
+
+    for(Size tile = 1; tile < num_tiles; ++tile)
+    {
+      if(comp(first[min_results[tile]], first[imin])) imin = min_results[tile];
+    }
+  }
+
+  if(find_max)
+  {
+    imax = max_results[0];
+
+    for(Size tile = 1; tile < num_tiles; ++tile)
+    {
+      if(comp(first[imax], first[max_results[tile]])) imax = max_results[tile];
+    }
+  }
+
+  return thrust::make_pair(imin, imax);
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename Iterator,
+         typename Size,
+         typename Compare>
+thrust::pair<Size,Size>
+  extrema(thrust::execution_policy<DerivedPolicy> &exec,
+          ParallelFor parallel_for,
+          Iterator first,
+          Size n,
+          Size num_tiles,
+          Size tile_size,
+          Compare,
+          bool find_min,
+          bool find_max,
+          less_value_order)
+{
+  typedef typename thrust::iterator_value<Iterator>::type T;
+
+  if(find_min && find_max)
+  {
+    return value_extrema(exec, parallel_for, first, n, num_tiles, tile_size, min_value<T>(), max_value<T>(), true, true);
+  }
+  else if(find_min)
+  {
+    return value_extrema(exec, parallel_for, first, n, num_tiles, tile_size, min_value<T>(), no_value<T>(), true, false);
+  }
+
+  return value_extrema(exec, parallel_for, first, n, num_tiles, tile_size, no_value<T>(), max_value<T>(), false, true);
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename Iterator,
+         typename Size,
+         typename Compare>
+thrust::pair<Size,Size>
+  extrema(thrust::execution_policy<DerivedPolicy> &exec,
+          ParallelFor parallel_for,
+          Iterator first,
+          Size n,
+          Size num_tiles,
+          Size tile_size,
+          Compare comp,
+          bool find_min,
+          bool find_max,
+          greater_value_order)
+{
+  // the least element under operator> is the greatest under operator<
+  thrust::pair<Size,Size> result =
+    extrema(exec, parallel_for, first, n, num_tiles, tile_size, comp, find_max, find_min, less_value_order());
+
+  return thrust::make_pair(result.second, result.first);
+}
+
+
+// the value-only passes read through a raw pointer when they can
+template<typename Iterator>
+const typename thrust::iterator_value<Iterator>::type *
+  value_iterator(Iterator first, thrust::detail::true_type /* is contiguous */)
+{
+  return &thrust::raw_reference_cast(*first);
+}
+
+template<typename Iterator>
+Iterator value_iterator(Iterator first, thrust::detail::false_type)
+{
+  return first;
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename BinaryPredicate>
+thrust::pair<RandomAccessIterator,RandomAccessIterator>
+  tiled_extrema(thrust::execution_policy<DerivedPolicy> &exec,
+                ParallelFor parallel_for,
+                RandomAccessIterator first,
+                RandomAccessIterator last,
+                BinaryPredicate comp,
+                bool find_min,
+                bool find_max)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type Size;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      T;
+
+  const Size n = last - first;
+
+  if(n == 0) return thrust::make_pair(first, first);
+
+  const Size min_tiles = (n + min_tile_size - 1) / min_tile_size;
+  const Size num_tiles = (min_tiles < max_tiles) ? min_tiles : Size(max_tiles);
+  const Size tile_size = (n + num_tiles - 1) / num_tiles;
+
+  typedef typename value_order<BinaryPredicate,T>::type order;
+
+  // only value orders benefit from reading through a raw pointer
+  typedef thrust::detail::integral_constant<
+    bool,
+    thrust::is_contiguous_iterator<RandomAccessIterator>::value &&
+    !thrust::detail::is_same<order, no_value_order>::value
+  > use_raw_pointer;
+
+  thrust::pair<Size,Size> result =
+    extrema(exec, parallel_for, value_iterator(first, use_raw_pointer()), n, num_tiles, tile_size, comp, find_min, find_max, order());
+
+  return thrust::make_pair(first + result.first, first + result.second);
+}
+
+
+} // end tiled_extrema_detail
+
+
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+//
+// Each tile of the input is reduced in parallel and the tiles' results are
+// combined in order, so that the first of several equivalent extrema is
+// found, as in the sequential algorithms. When the elements are arithmetic
+// and comp is less or greater, the tiles are reduced to their extreme
+// values only, and the position of the extremum is then found in the first
+// tile which holds it.
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename BinaryPredicate>
+RandomAccessIterator tiled_min_element(thrust::execution_policy<DerivedPolicy> &exec,
+                                       ParallelFor parallel_for,
+                                       RandomAccessIterator first,
+                                       RandomAccessIterator last,
+                                       BinaryPredicate comp)
+{
+  return tiled_extrema_detail::tiled_extrema(exec, parallel_for, first, last, comp, true, false).first;
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename BinaryPredicate>
+RandomAccessIterator tiled_max_element(thrust::execution_policy<DerivedPolicy> &exec,
+                                       ParallelFor parallel_for,
+                                       RandomAccessIterator first,
+                                       RandomAccessIterator last,
+                                       BinaryPredicate comp)
+{
+  return tiled_extrema_detail::tiled_extrema(exec, parallel_for, first, last, comp, false, true).second;
+}
+
+
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator,
+         typename BinaryPredicate>
+thrust::pair<RandomAccessIterator,RandomAccessIterator>
+  tiled_minmax_element(thrust::execution_policy<DerivedPolicy> &exec,
+                       ParallelFor parallel_for,
+                       RandomAccessIterator first,
+                       RandomAccessIterator last,
+                       BinaryPredicate comp)
+{
+  return tiled_extrema_detail::tiled_extrema(exec, parallel_for, first, last, comp, true, true);
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
@@ -0,0 +1,394 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file tiled_scan_by_key.h
+ *  \brief Parallel segmented scans shared by the host parallel systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/addressable_iterator.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace tiled_scan_by_key_detail
+{
+
+
+// the number of tiles is bounded so that the carries can be propagated
+// sequentially, and tiles are large enough to amortize launching them
+const int max_tiles     = 256;
+const int min_tile_size = 1 << 12;
+
+
+template<typename Size>
+struct tile_status
+{
+  // whether the tile's first segment began in an earlier tile
+  bool continues;
+
+  // the end of the tile's first segment, which must be combined with the
+  // carry from the earlier tiles. Equal to the tile's end when the whole tile
+  // continues the segment of the earlier tile
+  Size leading_end;
+};
+
+
+// the scans are computed by three passes
+//   1. every tile scans its segments, assuming nothing precedes it, and
+//      records the partial sum of its last segment as its carry
+//   2. the carries are propagated across the tiles sequentially
+//   3. every tile combines the carry into the elements of its first segment
+// Only the first segment of each tile is touched again in the third pass, so
+// the keys and values are read once.
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename ValueType,
+         typename Size,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         bool Inclusive>
+struct scan_tiles
+{
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 values;
+  RandomAccessIterator3 result;
+  ValueType *carries;
+  tile_status<Size> *status;
+  Size n, tile_size;
+  ValueType init;
+  BinaryPredicate pred;
+  BinaryFunction op;
+
+  // returns the inclusive scan of the tile's last segment
+  ValueType scan_tile(Size begin, Size end, tile_status<Size> &s, thrust::detail::true_type) const
+  {
+    thrust::detail::wrapped_function<BinaryPredicate,bool>     wrapped_pred(pred);
+    thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_op(op);
+
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+    RandomAccessIterator1 key_iter   = keys   + begin;
+    RandomAccessIterator2 value_iter = values + begin;
+    RandomAccessIterator3 out        = result + begin;
+
+    KeyType   prev_key = *key_iter;
+    ValueType sum      = *value_iter;
+
+    *out = sum;
+
+    Size i = begin + 1;
+
+    for(++key_iter, ++value_iter, ++out; i < end; ++i, ++key_iter, ++value_iter, ++out)
+    {
+      KeyType key = *key_iter;
+
+      if(wrapped_pred(prev_key, key))
+      {
+        sum = wrapped_op(sum, *value_iter);
+      }
+      else
+      {
+        sum = *value_iter;
+
+        if(s.continues && s.leading_end == end)
+        {
+          s.leading_end = i;
+        }
+      }
+
+      *out = sum;
+      prev_key = key;
+    }
+
+    return sum;
+  }
+
+  // returns the value following the exclusive scan of the tile's last segment
+  ValueType scan_tile(Size begin, Size end, tile_status<Size> &s, thrust::detail::false_type) const
+  {
+    thrust::detail::wrapped_function<BinaryPredicate,bool>     wrapped_pred(pred);
+    thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_op(op);
+
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+    RandomAccessIterator1 key_iter   = keys   + begin;
+    RandomAccessIterator2 value_iter = values + begin;
+    RandomAccessIterator3 out        = result + begin;
+
+    KeyType   prev_key = *key_iter;
+    ValueType next     = *value_iter;
+
+    // the first segment's prefix leaves out the carry, which the third pass
+    // stores in the tile's first element
+    if(!s.continues)
+    {
+      *out = init;
+      next = wrapped_op(init, next);
+    }
+
+    Size i = begin + 1;
+
+    for(++key_iter, ++value_iter, ++out; i < end; ++i, ++key_iter, ++value_iter, ++out)
+    {
+      KeyType key = *key_iter;
+
+      // use a temporary to permit in-place scans
+      ValueType value = *value_iter;
+
+      if(!wrapped_pred(prev_key, key))
+      {
+        next = init;
+
+        if(s.continues && s.leading_end == end)
+        {
+          s.leading_end = i;
+        }
+      }
+
+      *out = next;
+      next = wrapped_op(next, value);
+      prev_key = key;
+    }
+
+    return next;
+  }
+
+  void operator()(Size tile_idx) const
+  {
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    tile_status<Size> &s = status[tile_idx];
+
+    s.leading_end = s.continues ? end : begin;
+
+    carries[tile_idx] = scan_tile(begin, end, s, thrust::detail::integral_constant<bool,Inclusive>());
+  }
+};
+
+
+template<typename RandomAccessIterator, typename ValueType, typename Size, typename BinaryFunction, bool Inclusive>
+struct add_carries
+{
+  RandomAccessIterator result;
+  const ValueType *carries;
+  const tile_status<Size> *status;
+  Size tile_size;
+  BinaryFunction op;
+
+  void operator()(Size tile_idx) const
+  {
+    const tile_status<Size> &s = status[tile_idx];
+
+    if(!s.continues) return;
+
+    thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_op(op);
+
+    // after propagation, a tile's carry is the carry into the tile
+    const ValueType carry = carries[tile_idx];
+
+    Size i = tile_idx * tile_size;
+
+    if(!Inclusive)
+    {
+      result[i] = carry;
+      ++i;
+    }
+
+    for(; i < s.leading_end; ++i)
+    {
+      result[i] = wrapped_op(carry, result[i]);
+    }
+  }
+};
+
+
+template<bool Inclusive,
+         typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename ValueType,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+RandomAccessIterator3 scan_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                                  ParallelFor parallel_for,
+                                  RandomAccessIterator1 first1,
+                                  RandomAccessIterator1 last1,
+                                  RandomAccessIterator2 first2,
+                                  RandomAccessIterator3 result,
+                                  ValueType init,
+                                  BinaryPredicate binary_pred,
+                                  BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size n = last1 - first1;
+
+  if(n <= 0) return result;
+
+  Size num_tiles = (n + min_tile_size - 1) / min_tile_size;
+  num_tiles = (num_tiles < max_tiles) ? num_tiles : Size(max_tiles);
+
+  const Size tile_size = (n + num_tiles - 1) / num_tiles;
+
+  // tile_size is rounded up, so the last tiles may be empty
+  num_tiles = (n + tile_size - 1) / tile_size;
+
+  thrust::detail::temporary_array<ValueType, DerivedPolicy>         carries(exec, num_tiles);
+  thrust::detail::temporary_array<tile_status<Size>, DerivedPolicy> status(exec, num_tiles);
+
+  ValueType         *carries_ptr = thrust::raw_pointer_cast(&*carries.begin());
+  tile_status<Size> *status_ptr  = thrust::raw_pointer_cast(&*status.begin());
+
+  thrust::detail::wrapped_function<BinaryPredicate,bool>     wrapped_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_op(binary_op);
+
+  // find the tiles whose first segment began earlier before any output is
+  // written, in case the output overwrites the keys
+  status_ptr[0].continues = false;
+
+  for(Size i = 1; i < num_tiles; ++i)
+  {
+    status_ptr[i].continues = wrapped_pred(first1[i * tile_size - 1], first1[i * tile_size]);
+  }
+
+  scan_tiles<RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,ValueType,Size,BinaryPredicate,BinaryFunction,Inclusive> scan =
+    {first1, first2, result, carries_ptr, status_ptr, n, tile_size, init, binary_pred, binary_op};
+
+  if(num_tiles == 1)
+  {
+    // don't pay for a parallel launch to scan a single tile
+    scan(0);
+    return result + n;
+  }
+
+  parallel_for(num_tiles, scan);
+
+  // replace every tile's carry by the carry into it
+  ValueType carry = carries_ptr[0];
+
+  for(Size i = 1; i < num_tiles; ++i)
+  {
+    ValueType tile_carry = carries_ptr[i];
+
+    carries_ptr[i] = carry;
+
+    // a tile which holds a segment head starts a fresh carry
+    const tile_status<Size> &s = status_ptr[i];
+    const Size end = (n - i * tile_size < tile_size) ? n : (i + 1) * tile_size;
+
+    carry = (s.continues && s.leading_end == end) ? wrapped_op(carry, tile_carry) : tile_carry;
+  }
+
+  add_carries<RandomAccessIterator3,ValueType,Size,BinaryFunction,Inclusive> add =
+    {result, carries_ptr, status_ptr, tile_size, binary_op};
+
+  parallel_for(num_tiles, add);
+
+  return result + n;
+}
+
+
+} // end tiled_scan_by_key_detail
+
+
+// true when tiled_inclusive_scan_by_key and tiled_exclusive_scan_by_key
+// accept the iterators: the result is read back to add the carries
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator>
+struct use_tiled_scan_by_key
+  : thrust::detail::integral_constant<
+      bool,
+      is_random_access_iterator<InputIterator1>::value &&
+      is_random_access_iterator<InputIterator2>::value &&
+      is_addressable_random_access_iterator<OutputIterator>::value
+    >
+{};
+
+
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+// binary_op must be associative
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+RandomAccessIterator3 tiled_inclusive_scan_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                                                  ParallelFor parallel_for,
+                                                  RandomAccessIterator1 first1,
+                                                  RandomAccessIterator1 last1,
+                                                  RandomAccessIterator2 first2,
+                                                  RandomAccessIterator3 result,
+                                                  BinaryPredicate binary_pred,
+                                                  BinaryFunction binary_op)
+{
+  // like the sequential scan_by_key, accumulate in the output's value type
+  typedef typename thrust::iterator_value<RandomAccessIterator3>::type ValueType;
+
+  if(first1 == last1) return result;
+
+  return tiled_scan_by_key_detail::scan_by_key<true>(exec, parallel_for, first1, last1, first2, result,
+                                                     ValueType(*first2), binary_pred, binary_op);
+}
+
+
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+// binary_op must be associative
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+RandomAccessIterator3 tiled_exclusive_scan_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                                                  ParallelFor parallel_for,
+                                                  RandomAccessIterator1 first1,
+                                                  RandomAccessIterator1 last1,
+                                                  RandomAccessIterator2 first2,
+                                                  RandomAccessIterator3 result,
+                                                  T init,
+                                                  BinaryPredicate binary_pred,
+                                                  BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator3>::type ValueType;
+
+  return tiled_scan_by_key_detail::scan_by_key<false>(exec, parallel_for, first1, last1, first2, result,
+                                                      ValueType(init), binary_pred, binary_op);
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
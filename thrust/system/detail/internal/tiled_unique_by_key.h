@@ -0,0 +1,455 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file tiled_unique_by_key.h
+ *  \brief Parallel unique_by_key and unique_by_key_copy shared by the host
+ *         parallel systems.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/pair.h>
+#include <thrust/system/detail/internal/addressable_iterator.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace tiled_unique_by_key_detail
+{
+
+
+// the number of tiles is bounded so that their counts can be scanned
+// sequentially, and tiles are large enough to amortize launching them
+const int max_tiles     = 256;
+const int min_tile_size = 1 << 12;
+
+
+template<typename Size>
+struct tile_status
+{
+  // whether the tile's first element is the head of a segment
+  bool head;
+
+  // the number of segment heads in the tile
+  Size count;
+
+  // the position of the tile's first head in the output
+  Size offset;
+};
+
+
+// computes the tiling of n elements, returns the number of tiles
+template<typename Size>
+Size partition_tiles(Size n, Size &tile_size)
+{
+  Size num_tiles = (n + min_tile_size - 1) / min_tile_size;
+  num_tiles = (num_tiles < max_tiles) ? num_tiles : Size(max_tiles);
+
+  tile_size = (n + num_tiles - 1) / num_tiles;
+
+  // tile_size is rounded up, so the last tiles may be empty
+  return (n + tile_size - 1) / tile_size;
+}
+
+
+// records whether every tile's first element is a segment head. This is
+// done before any output is written, in case the output overwrites the keys
+template<typename RandomAccessIterator, typename Size, typename BinaryPredicate>
+void find_tile_heads(RandomAccessIterator keys,
+                     tile_status<Size> *status,
+                     Size num_tiles,
+                     Size tile_size,
+                     BinaryPredicate binary_pred)
+{
+  thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_pred(binary_pred);
+
+  status[0].head = true;
+
+  for(Size i = 1; i < num_tiles; ++i)
+  {
+    status[i].head = !wrapped_pred(keys[i * tile_size - 1], keys[i * tile_size]);
+  }
+}
+
+
+// computes every tile's offset into the output, returns the size of the
+// output
+template<typename Size>
+Size scan_tile_counts(tile_status<Size> *status, Size num_tiles)
+{
+  Size sum = 0;
+
+  for(Size i = 0; i < num_tiles; ++i)
+  {
+    status[i].offset = sum;
+    sum += status[i].count;
+  }
+
+  return sum;
+}
+
+
+template<typename RandomAccessIterator, typename Size, typename BinaryPredicate>
+struct count_tiles
+{
+  RandomAccessIterator keys;
+  tile_status<Size> *status;
+  Size n, tile_size;
+  BinaryPredicate pred;
+
+  void operator()(Size tile_idx) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+    thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_pred(pred);
+
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    RandomAccessIterator key_iter = keys + begin;
+    RandomAccessIterator key_end  = keys + end;
+
+    KeyType prev_key = *key_iter;
+
+    Size count = status[tile_idx].head ? 1 : 0;
+
+    for(++key_iter; key_iter != key_end; ++key_iter)
+    {
+      KeyType key = *key_iter;
+
+      count += wrapped_pred(prev_key, key) ? 0 : 1;
+
+      prev_key = key;
+    }
+
+    status[tile_idx].count = count;
+  }
+};
+
+
+// copies the heads of every tile to the tile's offset in the output, which
+// requires the tile's count
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename Size,
+         typename BinaryPredicate>
+struct copy_tiles
+{
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 values;
+  RandomAccessIterator3 keys_output;
+  RandomAccessIterator4 values_output;
+  const tile_status<Size> *status;
+  Size tile_size;
+  BinaryPredicate pred;
+
+  void operator()(Size tile_idx) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+    thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_pred(pred);
+
+    const tile_status<Size> &s = status[tile_idx];
+
+    const Size begin = tile_idx * tile_size;
+
+    RandomAccessIterator1 key_iter   = keys + begin;
+    RandomAccessIterator2 value_iter = values + begin;
+
+    RandomAccessIterator3 key_out   = keys_output   + s.offset;
+    RandomAccessIterator4 value_out = values_output + s.offset;
+
+    // until the tile's last head is written, the next output position is
+    // the tile's own, so it is written whether or not the key is a head, and
+    // advanced without a branch
+    Size remaining = s.count;
+
+    KeyType prev_key = *key_iter;
+
+    if(s.head)
+    {
+      *key_out   = prev_key;
+      *value_out = *value_iter;
+
+      ++key_out;
+      ++value_out;
+      --remaining;
+    }
+
+    for(++key_iter, ++value_iter; remaining > 0; ++key_iter, ++value_iter)
+    {
+      KeyType key = *key_iter;
+
+      *key_out   = key;
+      *value_out = *value_iter;
+
+      const Size head = wrapped_pred(prev_key, key) ? 0 : 1;
+
+      key_out   += head;
+      value_out += head;
+      remaining -= head;
+
+      prev_key = key;
+    }
+  }
+};
+
+
+// moves the heads of every tile to the tile's front. Heads only move towards
+// the front of their own tile, so the tiles are independent
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename BinaryPredicate>
+struct compact_tiles
+{
+  RandomAccessIterator1 keys;
+  RandomAccessIterator2 values;
+  tile_status<Size> *status;
+  Size n, tile_size;
+  BinaryPredicate pred;
+
+  void operator()(Size tile_idx) const
+  {
+    typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+    thrust::detail::wrapped_function<BinaryPredicate,bool> wrapped_pred(pred);
+
+    const Size begin = tile_idx * tile_size;
+    const Size end   = (n - begin < tile_size) ? n : begin + tile_size;
+
+    RandomAccessIterator1 key_iter   = keys + begin;
+    RandomAccessIterator1 key_end    = keys + end;
+    RandomAccessIterator2 value_iter = values + begin;
+
+    // a leading head is already in place
+    RandomAccessIterator1 key_out   = key_iter;
+    RandomAccessIterator2 value_out = value_iter;
+
+    if(status[tile_idx].head)
+    {
+      ++key_out;
+      ++value_out;
+    }
+
+    // the key at the front may be overwritten, so compare against a copy
+    KeyType prev_key = *key_iter;
+
+    for(++key_iter, ++value_iter; key_iter != key_end; ++key_iter, ++value_iter)
+    {
+      KeyType key = *key_iter;
+
+      // the output never passes the input, so it is written whether or not
+      // the key is a head, and advanced without a branch
+      *key_out   = key;
+      *value_out = *value_iter;
+
+      const Size head = wrapped_pred(prev_key, key) ? 0 : 1;
+
+      key_out   += head;
+      value_out += head;
+
+      prev_key = key;
+    }
+
+    status[tile_idx].count = key_out - (keys + begin);
+  }
+};
+
+
+} // end tiled_unique_by_key_detail
+
+
+// true when tiled_unique_by_key accepts the iterators
+template<typename ForwardIterator1, typename ForwardIterator2>
+struct use_tiled_unique_by_key
+  : thrust::detail::integral_constant<
+      bool,
+      is_random_access_iterator<ForwardIterator1>::value &&
+      is_random_access_iterator<ForwardIterator2>::value
+    >
+{};
+
+
+// true when tiled_unique_by_key_copy accepts the iterators
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator1, typename OutputIterator2>
+struct use_tiled_unique_by_key_copy
+  : thrust::detail::integral_constant<
+      bool,
+      is_random_access_iterator<InputIterator1>::value &&
+      is_random_access_iterator<InputIterator2>::value &&
+      is_random_access_iterator<OutputIterator1>::value &&
+      is_random_access_iterator<OutputIterator2>::value
+    >
+{};
+
+
+// Every tile compacts its segment heads to its front in place, in parallel.
+// The compacted tiles are then moved to their final positions in order,
+// which touches only the elements that are kept, and needs no temporary
+// copies of the keys or values.
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename BinaryPredicate>
+thrust::pair<RandomAccessIterator1,RandomAccessIterator2>
+  tiled_unique_by_key(thrust::execution_policy<DerivedPolicy> &exec,
+                      ParallelFor parallel_for,
+                      RandomAccessIterator1 keys_first,
+                      RandomAccessIterator1 keys_last,
+                      RandomAccessIterator2 values_first,
+                      BinaryPredicate binary_pred)
+{
+  namespace ns = tiled_unique_by_key_detail;
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size n = keys_last - keys_first;
+
+  if(n <= 0) return thrust::make_pair(keys_first, values_first);
+
+  Size tile_size;
+  const Size num_tiles = ns::partition_tiles(n, tile_size);
+
+  thrust::detail::temporary_array<ns::tile_status<Size>, DerivedPolicy> status(exec, num_tiles);
+
+  ns::tile_status<Size> *status_ptr = thrust::raw_pointer_cast(&*status.begin());
+
+  ns::find_tile_heads(keys_first, status_ptr, num_tiles, tile_size, binary_pred);
+
+  ns::compact_tiles<RandomAccessIterator1,RandomAccessIterator2,Size,BinaryPredicate> compact =
+    {keys_first, values_first, status_ptr, n, tile_size, binary_pred};
+
+  if(num_tiles == 1)
+  {
+    // don't pay for a parallel launch to compact a single tile
+    compact(0);
+  }
+  else
+  {
+    parallel_for(num_tiles, compact);
+  }
+
+  const Size result_size = ns::scan_tile_counts(status_ptr, num_tiles);
+
+  // a tile's destination may overlap the compacted heads of the tiles before
+  // it, so the tiles are moved in order
+  for(Size i = 1; i < num_tiles; ++i)
+  {
+    const ns::tile_status<Size> &s = status_ptr[i];
+
+    const Size begin = i * tile_size;
+
+    if(s.offset == begin) continue;
+
+    RandomAccessIterator1 key_iter   = keys_first   + begin;
+    RandomAccessIterator2 value_iter = values_first + begin;
+
+    RandomAccessIterator1 key_out   = keys_first   + s.offset;
+    RandomAccessIterator2 value_out = values_first + s.offset;
+
+    for(Size j = 0; j < s.count; ++j, ++key_iter, ++value_iter, ++key_out, ++value_out)
+    {
+      *key_out   = *key_iter;
+      *value_out = *value_iter;
+    }
+  }
+
+  return thrust::make_pair(keys_first + result_size, values_first + result_size);
+}
+
+
+// Every tile counts its segment heads, and then copies them to the output at
+// the sum of the counts of the tiles before it.
+// parallel_for(count, f) must invoke f(i) for every i in [0, count)
+template<typename DerivedPolicy,
+         typename ParallelFor,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename BinaryPredicate>
+thrust::pair<RandomAccessIterator3,RandomAccessIterator4>
+  tiled_unique_by_key_copy(thrust::execution_policy<DerivedPolicy> &exec,
+                           ParallelFor parallel_for,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           RandomAccessIterator3 keys_output,
+                           RandomAccessIterator4 values_output,
+                           BinaryPredicate binary_pred)
+{
+  namespace ns = tiled_unique_by_key_detail;
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size n = keys_last - keys_first;
+
+  if(n <= 0) return thrust::make_pair(keys_output, values_output);
+
+  Size tile_size;
+  const Size num_tiles = ns::partition_tiles(n, tile_size);
+
+  thrust::detail::temporary_array<ns::tile_status<Size>, DerivedPolicy> status(exec, num_tiles);
+
+  ns::tile_status<Size> *status_ptr = thrust::raw_pointer_cast(&*status.begin());
+
+  ns::find_tile_heads(keys_first, status_ptr, num_tiles, tile_size, binary_pred);
+
+  ns::count_tiles<RandomAccessIterator1,Size,BinaryPredicate> count =
+    {keys_first, status_ptr, n, tile_size, binary_pred};
+
+  ns::copy_tiles<RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3,RandomAccessIterator4,Size,BinaryPredicate> copy =
+    {keys_first, values_first, keys_output, values_output, status_ptr, tile_size, binary_pred};
+
+  Size result_size;
+
+  if(num_tiles == 1)
+  {
+    // don't pay for parallel launches to copy a single tile
+    count(0);
+    result_size = ns::scan_tile_counts(status_ptr, num_tiles);
+    copy(0);
+  }
+  else
+  {
+    parallel_for(num_tiles, count);
+    result_size = ns::scan_tile_counts(status_ptr, num_tiles);
+    parallel_for(num_tiles, copy);
+  }
+
+  return thrust::make_pair(keys_output + result_size, values_output + result_size);
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
@@ -0,0 +1,128 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file histogram.h
+ *  \brief Sequential implementations of histogram functions.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/histogram_bins.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+namespace histogram_detail
+{
+
+
+__thrust_exec_check_disable__
+template<typename InputIterator,
+         typename RandomAccessIterator,
+         typename Bins,
+         typename Size>
+__host__ __device__
+  RandomAccessIterator bin_histogram(InputIterator first,
+                                     InputIterator last,
+                                     RandomAccessIterator histogram,
+                                     Bins bins,
+                                     Size num_bins)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type Counter;
+
+  if(num_bins <= 0) return histogram;
+
+  for(Size i = 0; i < num_bins; ++i)
+  {
+    histogram[i] = Counter(0);
+  }
+
+  for(; first != last; ++first)
+  {
+    const Size bin = bins(*first);
+
+    if(bin < num_bins)
+    {
+      const Counter count = histogram[bin];
+
+      histogram[bin] = count + Counter(1);
+    }
+  }
+
+  return histogram + num_bins;
+} // end bin_histogram()
+
+
+} // end histogram_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename Level>
+__host__ __device__
+  RandomAccessIterator histogram_even(sequential::execution_policy<DerivedPolicy> &,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      Level lower_level,
+                                      Level upper_level)
+{
+  return histogram_detail::bin_histogram(first, last, histogram,
+                                         thrust::detail::even_bins<Level,Size>(lower_level, upper_level, num_bins),
+                                         num_bins);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+__host__ __device__
+  RandomAccessIterator2 histogram_range(sequential::execution_policy<DerivedPolicy> &,
+                                        InputIterator first,
+                                        InputIterator last,
+                                        RandomAccessIterator1 levels_first,
+                                        RandomAccessIterator1 levels_last,
+                                        RandomAccessIterator2 histogram)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size num_levels = levels_last - levels_first;
+
+  if(num_levels < 2) return histogram;
+
+  const thrust::detail::range_bins<RandomAccessIterator1,Size> bins = {levels_first, num_levels};
+
+  return histogram_detail::bin_histogram(first, last, histogram, bins, num_levels - 1);
+} // end histogram_range()
+
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
+
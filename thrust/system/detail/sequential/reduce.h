@@ -23,6 +23,11 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/detail/function.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_reference_cast.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/type_traits/is_contiguous_iterator.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
 
 namespace thrust
@@ -35,17 +40,69 @@ namespace sequential
 {
 
 
+namespace reduce_detail
+{
+
+
+// operators which are associative and commutative for arithmetic types, up
+// to floating point rounding, so that a range may be reduced in lanes
+template<typename BinaryFunction, typename T>
+struct is_lane_reducible_operator
+  : thrust::detail::false_type
+{};
+
+template<typename T>
+struct is_lane_reducible_operator<thrust::plus<T>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<thrust::plus<void>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<std::plus<T>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<thrust::multiplies<T>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<thrust::multiplies<void>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<std::multiplies<T>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<thrust::maximum<T>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<thrust::maximum<void>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<thrust::minimum<T>, T> : thrust::detail::true_type {};
+template<typename T>
+struct is_lane_reducible_operator<thrust::minimum<void>, T> : thrust::detail::true_type {};
+
+
+template<typename InputIterator, typename OutputType, typename BinaryFunction>
+struct use_lanes
+  : thrust::detail::integral_constant<
+      bool,
+      thrust::is_contiguous_iterator<InputIterator>::value &&
+      thrust::detail::is_arithmetic<typename thrust::iterator_value<InputIterator>::type>::value &&
+      thrust::detail::is_arithmetic<OutputType>::value &&
+      is_lane_reducible_operator<BinaryFunction, OutputType>::value
+    >
+{};
+
+
+// one cache line of partial results
+template<typename T>
+struct num_lanes
+{
+  static const int value = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+};
+
+
 __thrust_exec_check_disable__
-template<typename DerivedPolicy,
-         typename InputIterator, 
+template<typename InputIterator,
          typename OutputType,
          typename BinaryFunction>
 __host__ __device__
-  OutputType reduce(sequential::execution_policy<DerivedPolicy> &,
-                    InputIterator begin,
+  OutputType reduce(InputIterator begin,
                     InputIterator end,
                     OutputType init,
-                    BinaryFunction binary_op)
+                    BinaryFunction binary_op,
+                    thrust::detail::false_type)
 {
   // wrap binary_op
   thrust::detail::wrapped_function<
@@ -66,6 +123,118 @@ __host__ __device__
 }
 
 
+// reduces a contiguous range of arithmetic values into independent lanes,
+// which breaks the loop-carried dependence on the result and lets the
+// compiler keep the lanes in vector registers. The lanes are combined
+// pairwise at the end.
+__thrust_exec_check_disable__
+template<typename InputType,
+         typename OutputType,
+         typename BinaryFunction>
+__host__ __device__
+  OutputType reduce_lanes(const InputType *begin,
+                          const InputType *end,
+                          OutputType init,
+                          BinaryFunction binary_op)
+{
+  thrust::detail::wrapped_function<
+    BinaryFunction,
+    OutputType
+  > wrapped_binary_op(binary_op);
+
+  const int lanes = num_lanes<OutputType>::value;
+
+  OutputType result = init;
+
+  if(end - begin >= 2 * lanes)
+  {
+    OutputType partial[lanes];
+
+    for(int j = 0; j < lanes; ++j)
+    {
+      partial[j] = begin[j];
+    }
+
+    for(begin += lanes; end - begin >= lanes; begin += lanes)
+    {
+      for(int j = 0; j < lanes; ++j)
+      {
+        partial[j] = wrapped_binary_op(partial[j], begin[j]);
+      }
+    }
+
+    for(int width = lanes / 2; width > 0; width /= 2)
+    {
+      for(int j = 0; j < width; ++j)
+      {
+        partial[j] = wrapped_binary_op(partial[j], partial[j + width]);
+      }
+    }
+
+    result = wrapped_binary_op(result, partial[0]);
+  }
+
+  for(; begin != end; ++begin)
+  {
+    result = wrapped_binary_op(result, *begin);
+  }
+
+  return result;
+}
+
+
+template<typename InputIterator,
+         typename OutputType,
+         typename BinaryFunction>
+__host__ __device__
+  OutputType reduce(InputIterator begin,
+                    InputIterator end,
+                    OutputType init,
+                    BinaryFunction binary_op,
+                    thrust::detail::true_type)
+{
+  if(begin == end) return init;
+
+  OutputType result = init;
+
+  if (THRUST_IS_HOST_CODE) {
+    #if THRUST_INCLUDE_HOST_CODE
+      typedef typename thrust::iterator_value<InputIterator>::type InputType;
+
+      const InputType *raw_begin = &thrust::raw_reference_cast(*begin);
+
+      result = reduce_detail::reduce_lanes(raw_begin, raw_begin + (end - begin), init, binary_op);
+    #endif
+  } else {
+    #if THRUST_INCLUDE_DEVICE_CODE
+      // keep the partial results out of local memory in CUDA threads
+      result = reduce_detail::reduce(begin, end, init, binary_op, thrust::detail::false_type());
+    #endif
+  }
+
+  return result;
+}
+
+
+} // end reduce_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator, 
+         typename OutputType,
+         typename BinaryFunction>
+__host__ __device__
+  OutputType reduce(sequential::execution_policy<DerivedPolicy> &,
+                    InputIterator begin,
+                    InputIterator end,
+                    OutputType init,
+                    BinaryFunction binary_op)
+{
+  return reduce_detail::reduce(begin, end, init, binary_op,
+    typename reduce_detail::use_lanes<InputIterator,OutputType,BinaryFunction>::type());
+}
+
+
 } // end namespace sequential
 } // end namespace detail
 } // end namespace system
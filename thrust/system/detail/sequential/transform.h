@@ -14,9 +14,59 @@
  *  limitations under the License.
  */
 
+/*! \file transform.h
+ *  \brief Sequential implementation of transform through permutation_iterators.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/detail/internal/prefetching_transform.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+
+// when either range is a permutation_iterator (e.g. in gather and scatter),
+// prefetch its permuted elements ahead of the loop. Other transforms use
+// the generic implementation.
+__thrust_exec_check_disable__
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename UnaryFunction>
+__host__ __device__
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_prefetching_transform<InputIterator,OutputIterator>::value,
+    OutputIterator
+  >::type
+    transform(sequential::execution_policy<DerivedPolicy> &,
+              InputIterator first,
+              InputIterator last,
+              OutputIterator result,
+              UnaryFunction op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type Size;
+
+  Size n = last - first;
+
+  thrust::system::detail::internal::transform_prefetching_range(first, result, Size(0), n, op);
+
+  return result + n;
+} // end transform()
+
 
-// this system has no special transform functions
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace thrust
 
@@ -19,6 +19,9 @@
 #include <thrust/detail/config.h>
 #include <thrust/system/omp/detail/execution_policy.h>
 #include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/omp/detail/index_parallel_for.h>
+#include <thrust/system/detail/internal/batched_binary_search.h>
+#include <thrust/detail/type_traits.h>
 
 namespace thrust
 {
@@ -66,6 +69,57 @@ bool binary_search(execution_policy<DerivedPolicy> &exec,
 }
 
 
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_batched_binary_search<ForwardIterator,InputIterator,OutputIterator>::value,
+    OutputIterator
+  >::type
+    lower_bound(execution_policy<DerivedPolicy> &,
+                ForwardIterator begin,
+                ForwardIterator end,
+                InputIterator values_begin,
+                InputIterator values_end,
+                OutputIterator output,
+                StrictWeakOrdering comp)
+{
+    return thrust::system::detail::internal::batched_lower_bound(index_parallel_for(), begin, end, values_begin, values_end, output, comp);
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_batched_binary_search<ForwardIterator,InputIterator,OutputIterator>::value,
+    OutputIterator
+  >::type
+    upper_bound(execution_policy<DerivedPolicy> &,
+                ForwardIterator begin,
+                ForwardIterator end,
+                InputIterator values_begin,
+                InputIterator values_end,
+                OutputIterator output,
+                StrictWeakOrdering comp)
+{
+    return thrust::system::detail::internal::batched_upper_bound(index_parallel_for(), begin, end, values_begin, values_end, output, comp);
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_batched_binary_search<ForwardIterator,InputIterator,OutputIterator>::value,
+    OutputIterator
+  >::type
+    binary_search(execution_policy<DerivedPolicy> &,
+                  ForwardIterator begin,
+                  ForwardIterator end,
+                  InputIterator values_begin,
+                  InputIterator values_end,
+                  OutputIterator output,
+                  StrictWeakOrdering comp)
+{
+    return thrust::system::detail::internal::batched_binary_search(index_parallel_for(), begin, end, values_begin, values_end, output, comp);
+}
+
+
 } // end detail
 } // end omp
 } // end system
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/system/omp/detail/histogram.h>
+#include <thrust/system/omp/detail/index_parallel_for.h>
+#include <thrust/system/detail/generic/histogram.h>
+#include <thrust/system/detail/internal/privatized_histogram.h>
+#include <thrust/detail/histogram_bins.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace histogram_detail
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename Level>
+  RandomAccessIterator histogram_even(execution_policy<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      Level lower_level,
+                                      Level upper_level,
+                                      thrust::detail::false_type)
+{
+  // omp prefers generic::histogram_even to cpp::histogram_even
+  return thrust::system::detail::generic::histogram_even(exec, first, last, histogram, num_bins, lower_level, upper_level);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename Level>
+  RandomAccessIterator2 histogram_even(execution_policy<DerivedPolicy> &exec,
+                                       RandomAccessIterator1 first,
+                                       RandomAccessIterator1 last,
+                                       RandomAccessIterator2 histogram,
+                                       Size num_bins,
+                                       Level lower_level,
+                                       Level upper_level,
+                                       thrust::detail::true_type)
+{
+  return thrust::system::detail::internal::privatized_histogram(exec, index_parallel_for(),
+    first, last, histogram, thrust::detail::even_bins<Level,Size>(lower_level, upper_level, num_bins), num_bins);
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+  RandomAccessIterator2 histogram_range(execution_policy<DerivedPolicy> &exec,
+                                        InputIterator first,
+                                        InputIterator last,
+                                        RandomAccessIterator1 levels_first,
+                                        RandomAccessIterator1 levels_last,
+                                        RandomAccessIterator2 histogram,
+                                        thrust::detail::false_type)
+{
+  // omp prefers generic::histogram_range to cpp::histogram_range
+  return thrust::system::detail::generic::histogram_range(exec, first, last, levels_first, levels_last, histogram);
+} // end histogram_range()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3>
+  RandomAccessIterator3 histogram_range(execution_policy<DerivedPolicy> &exec,
+                                        RandomAccessIterator1 first,
+                                        RandomAccessIterator1 last,
+                                        RandomAccessIterator2 levels_first,
+                                        RandomAccessIterator2 levels_last,
+                                        RandomAccessIterator3 histogram,
+                                        thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator2>::type Size;
+
+  const Size num_levels = levels_last - levels_first;
+
+  if(num_levels < 2) return histogram;
+
+  const thrust::detail::range_bins<RandomAccessIterator2,Size> bins = {levels_first, num_levels};
+
+  return thrust::system::detail::internal::privatized_histogram(exec, index_parallel_for(),
+    first, last, histogram, bins, num_levels - 1);
+} // end histogram_range()
+
+
+} // end histogram_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator,
+         typename Size,
+         typename Level>
+  RandomAccessIterator histogram_even(execution_policy<DerivedPolicy> &exec,
+                                      InputIterator first,
+                                      InputIterator last,
+                                      RandomAccessIterator histogram,
+                                      Size num_bins,
+                                      Level lower_level,
+                                      Level upper_level)
+{
+  return histogram_detail::histogram_even(exec, first, last, histogram, num_bins, lower_level, upper_level,
+    typename thrust::system::detail::internal::use_privatized_histogram<InputIterator,RandomAccessIterator>::type());
+} // end histogram_even()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2>
+  RandomAccessIterator2 histogram_range(execution_policy<DerivedPolicy> &exec,
+                                        InputIterator first,
+                                        InputIterator last,
+                                        RandomAccessIterator1 levels_first,
+                                        RandomAccessIterator1 levels_last,
+                                        RandomAccessIterator2 histogram)
+{
+  return histogram_detail::histogram_range(exec, first, last, levels_first, levels_last, histogram,
+    typename thrust::system::detail::internal::use_privatized_histogram<InputIterator,RandomAccessIterator2>::type());
+} // end histogram_range()
+
+
+} // end detail
+} // end omp
+} // end system
+} // end thrust
+
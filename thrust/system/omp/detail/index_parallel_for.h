@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file index_parallel_for.h
+ *  \brief Invokes a function on every index of a range in parallel.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// calls f(i) for every i in [0, n). This is the parallel loop which the
+// host systems pass to the drivers in thrust/system/detail/internal
+struct index_parallel_for
+{
+  template<typename Size, typename Function>
+  void operator()(Size n, Function f) const
+  {
+    // we're attempting to launch an omp kernel, assert we're compiling with omp support
+    // ========================================================================
+    // X Note to the user: If you've found this line due to a compiler error, X
+    // X you need to enable OpenMP support in your compiler.                  X
+    // ========================================================================
+    THRUST_STATIC_ASSERT_MSG(
+      (thrust::detail::depend_on_instantiation<
+        Function, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      >::value)
+    , "OpenMP compiler support is not enabled"
+    );
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#   pragma omp parallel for
+    for(Size i = 0; i < n; ++i)
+    {
+      f(i);
+    }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+  }
+};
+
+
+} // end detail
+} // end omp
+} // end system
+} // end thrust
+
@@ -52,6 +52,22 @@ template <typename DerivedPolicy,
                   BinaryFunction binary_op);
 
 
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_unsorted(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 keys_first,
+                           InputIterator1 keys_last,
+                           InputIterator2 values_first,
+                           OutputIterator1 keys_output,
+                           OutputIterator2 values_output,
+                           BinaryFunction binary_op);
+
+
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
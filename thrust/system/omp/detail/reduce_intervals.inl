@@ -20,6 +20,8 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
 #include <thrust/detail/cstdint.h>
+#include <thrust/reduce.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
 
 namespace thrust
 {
@@ -56,9 +58,6 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_value<OutputIterator>::type OutputType;
 
-  // wrap binary_op
-  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
-
   typedef thrust::detail::intptr_t index_type;
 
   index_type n = static_cast<index_type>(decomp.size());
@@ -77,11 +76,9 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 
       ++begin;
 
-      while (begin != end)
-      {
-        sum = wrapped_binary_op(sum, *begin);
-        ++begin;
-      }
+      // reduce the rest of the interval with the sequential system, which
+      // vectorizes contiguous ranges of arithmetic types
+      sum = thrust::reduce(thrust::system::detail::sequential::seq, begin, end, sum, binary_op);
 
       OutputIterator tmp = output + i;
       *tmp = sum;
@@ -14,10 +14,71 @@
  *  limitations under the License.
  */
 
+/*! \file scan_by_key.h
+ *  \brief OpenMP implementation of scan_by_key over random access ranges.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/detail/internal/tiled_scan_by_key.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_tiled_scan_by_key<RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3>::value,
+    RandomAccessIterator3
+  >::type
+    inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          RandomAccessIterator3 result,
+                          BinaryPredicate binary_pred,
+                          BinaryFunction binary_op);
 
-// this system inherits this algorithm
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_tiled_scan_by_key<RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3>::value,
+    RandomAccessIterator3
+  >::type
+    exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          RandomAccessIterator3 result,
+                          T init,
+                          BinaryPredicate binary_pred,
+                          BinaryFunction binary_op);
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
+// omp inherits the remaining scan_by_keys
 #include <thrust/system/cpp/detail/scan_by_key.h>
 
+#include <thrust/system/omp/detail/scan_by_key.inl>
+
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/system/omp/detail/execution_policy.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename URBG>
+  void shuffle(execution_policy<DerivedPolicy> &exec,
+               RandomIterator first,
+               RandomIterator last,
+               URBG &&g);
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename OutputIterator,
+         typename URBG>
+  void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                    RandomIterator first,
+                    RandomIterator last,
+                    OutputIterator result,
+                    URBG &&g);
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
+#include <thrust/system/omp/detail/shuffle.inl>
+
+#endif
+
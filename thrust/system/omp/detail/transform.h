@@ -1,5 +1,5 @@
 /*
- *  Copyright 2008-2013 NVIDIA Corporation
+ *  Copyright 2020 NVIDIA Corporation
  *
  *  Licensed under the Apache License, Version 2.0 (the "License");
  *  you may not use this file except in compliance with the License.
@@ -14,10 +14,47 @@
  *  limitations under the License.
  */
 
+/*! \file transform.h
+ *  \brief OpenMP implementation of transform through permutation_iterators.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/detail/internal/prefetching_transform.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
 
-// omp inherits transform
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename UnaryFunction>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_prefetching_transform<RandomAccessIterator1,RandomAccessIterator2>::value,
+    RandomAccessIterator2
+  >::type
+    transform(execution_policy<DerivedPolicy> &exec,
+              RandomAccessIterator1 first,
+              RandomAccessIterator1 last,
+              RandomAccessIterator2 result,
+              UnaryFunction op);
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
+// omp inherits the remaining transforms
 #include <thrust/system/cpp/detail/transform.h>
 
+#include <thrust/system/omp/detail/transform.inl>
+
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/omp/detail/transform.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename UnaryFunction>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_prefetching_transform<RandomAccessIterator1,RandomAccessIterator2>::value,
+    RandomAccessIterator2
+  >::type
+    transform(execution_policy<DerivedPolicy> &,
+              RandomAccessIterator1 first,
+              RandomAccessIterator1 last,
+              RandomAccessIterator2 result,
+              UnaryFunction op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+  const difference_type n = last - first;
+
+  // each thread walks one contiguous interval so that its prefetches run
+  // ahead of its own loads
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(n);
+
+// do not attempt to compile the body of this function, which depends on #pragma omp,
+// without support from the compiler
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  const difference_type num_intervals = decomp.size();
+
+# pragma omp parallel for
+  for(difference_type i = 0; i < num_intervals; ++i)
+  {
+    thrust::system::detail::internal::transform_prefetching_range(first, result, decomp[i].begin(), decomp[i].end(), op);
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return result + n;
+} // end transform()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+} // end namespace thrust
+
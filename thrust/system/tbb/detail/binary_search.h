@@ -14,10 +14,84 @@
  *  limitations under the License.
  */
 
+/*! \file binary_search.h
+ *  \brief TBB implementation of the vectorized binary searches.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/index_parallel_for.h>
+#include <thrust/system/detail/internal/batched_binary_search.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_batched_binary_search<ForwardIterator,InputIterator,OutputIterator>::value,
+    OutputIterator
+  >::type
+    lower_bound(execution_policy<DerivedPolicy> &,
+                ForwardIterator begin,
+                ForwardIterator end,
+                InputIterator values_begin,
+                InputIterator values_end,
+                OutputIterator output,
+                StrictWeakOrdering comp)
+{
+    return thrust::system::detail::internal::batched_lower_bound(index_parallel_for(), begin, end, values_begin, values_end, output, comp);
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_batched_binary_search<ForwardIterator,InputIterator,OutputIterator>::value,
+    OutputIterator
+  >::type
+    upper_bound(execution_policy<DerivedPolicy> &,
+                ForwardIterator begin,
+                ForwardIterator end,
+                InputIterator values_begin,
+                InputIterator values_end,
+                OutputIterator output,
+                StrictWeakOrdering comp)
+{
+    return thrust::system::detail::internal::batched_upper_bound(index_parallel_for(), begin, end, values_begin, values_end, output, comp);
+}
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_batched_binary_search<ForwardIterator,InputIterator,OutputIterator>::value,
+    OutputIterator
+  >::type
+    binary_search(execution_policy<DerivedPolicy> &,
+                  ForwardIterator begin,
+                  ForwardIterator end,
+                  InputIterator values_begin,
+                  InputIterator values_end,
+                  OutputIterator output,
+                  StrictWeakOrdering comp)
+{
+    return thrust::system::detail::internal::batched_binary_search(index_parallel_for(), begin, end, values_begin, values_end, output, comp);
+}
+
+
+} // end detail
+} // end tbb
+} // end system
+} // end thrust
 
-// this system inherits binary_search
+// tbb inherits the remaining binary searches
 #include <thrust/system/cpp/detail/binary_search.h>
 
@@ -18,7 +18,10 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/index_parallel_for.h>
 #include <thrust/system/detail/generic/extrema.h>
+#include <thrust/system/detail/internal/tiled_extrema.h>
+#include <thrust/iterator/iterator_traits.h>
 
 namespace thrust
 {
@@ -28,40 +31,106 @@ namespace tbb
 {
 namespace detail
 {
+namespace extrema_detail
+{
 
 template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
 ForwardIterator max_element(execution_policy<DerivedPolicy> &exec,
-                            ForwardIterator first, 
+                            ForwardIterator first,
                             ForwardIterator last,
-                            BinaryPredicate comp)
+                            BinaryPredicate comp,
+                            thrust::forward_traversal_tag)
 {
   // tbb prefers generic::max_element to cpp::max_element
   return thrust::system::detail::generic::max_element(exec, first, last, comp);
 } // end max_element()
 
+template <typename DerivedPolicy, typename RandomAccessIterator, typename BinaryPredicate>
+RandomAccessIterator max_element(execution_policy<DerivedPolicy> &exec,
+                                 RandomAccessIterator first,
+                                 RandomAccessIterator last,
+                                 BinaryPredicate comp,
+                                 thrust::random_access_traversal_tag)
+{
+  return thrust::system::detail::internal::tiled_max_element(exec, index_parallel_for(), first, last, comp);
+} // end max_element()
+
 template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
 ForwardIterator min_element(execution_policy<DerivedPolicy> &exec,
-                            ForwardIterator first, 
+                            ForwardIterator first,
                             ForwardIterator last,
-                            BinaryPredicate comp)
+                            BinaryPredicate comp,
+                            thrust::forward_traversal_tag)
 {
   // tbb prefers generic::min_element to cpp::min_element
   return thrust::system::detail::generic::min_element(exec, first, last, comp);
 } // end min_element()
 
+template <typename DerivedPolicy, typename RandomAccessIterator, typename BinaryPredicate>
+RandomAccessIterator min_element(execution_policy<DerivedPolicy> &exec,
+                                 RandomAccessIterator first,
+                                 RandomAccessIterator last,
+                                 BinaryPredicate comp,
+                                 thrust::random_access_traversal_tag)
+{
+  return thrust::system::detail::internal::tiled_min_element(exec, index_parallel_for(), first, last, comp);
+} // end min_element()
+
 template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
 thrust::pair<ForwardIterator,ForwardIterator> minmax_element(execution_policy<DerivedPolicy> &exec,
-                                                             ForwardIterator first, 
+                                                             ForwardIterator first,
                                                              ForwardIterator last,
-                                                             BinaryPredicate comp)
+                                                             BinaryPredicate comp,
+                                                             thrust::forward_traversal_tag)
 {
   // tbb prefers generic::minmax_element to cpp::minmax_element
   return thrust::system::detail::generic::minmax_element(exec, first, last, comp);
 } // end minmax_element()
 
+template <typename DerivedPolicy, typename RandomAccessIterator, typename BinaryPredicate>
+thrust::pair<RandomAccessIterator,RandomAccessIterator> minmax_element(execution_policy<DerivedPolicy> &exec,
+                                                                       RandomAccessIterator first,
+                                                                       RandomAccessIterator last,
+                                                                       BinaryPredicate comp,
+                                                                       thrust::random_access_traversal_tag)
+{
+  return thrust::system::detail::internal::tiled_minmax_element(exec, index_parallel_for(), first, last, comp);
+} // end minmax_element()
+
+} // end extrema_detail
+
+template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator max_element(execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first, 
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+  return extrema_detail::max_element(exec, first, last, comp,
+    typename thrust::iterator_traversal<ForwardIterator>::type());
+} // end max_element()
+
+template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator min_element(execution_policy<DerivedPolicy> &exec,
+                            ForwardIterator first, 
+                            ForwardIterator last,
+                            BinaryPredicate comp)
+{
+  return extrema_detail::min_element(exec, first, last, comp,
+    typename thrust::iterator_traversal<ForwardIterator>::type());
+} // end min_element()
+
+template <typename DerivedPolicy, typename ForwardIterator, typename BinaryPredicate>
+thrust::pair<ForwardIterator,ForwardIterator> minmax_element(execution_policy<DerivedPolicy> &exec,
+                                                             ForwardIterator first, 
+                                                             ForwardIterator last,
+                                                             BinaryPredicate comp)
+{
+  return extrema_detail::minmax_element(exec, first, last, comp,
+    typename thrust::iterator_traversal<ForwardIterator>::type());
+} // end minmax_element()
+
 } // end detail
 } // end tbb
 } // end system
 } // end thrust
 
-
@@ -19,6 +19,9 @@
 #include <thrust/detail/config.h>
 #include <thrust/system/detail/generic/find.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/index_parallel_for.h>
+#include <thrust/system/detail/internal/early_exit_find.h>
+#include <thrust/iterator/iterator_traits.h>
 
 namespace thrust
 {
@@ -29,16 +32,44 @@ namespace tbb
 namespace detail
 {
 
+namespace find_detail
+{
+
 template <typename DerivedPolicy, typename InputIterator, typename Predicate>
 InputIterator find_if(execution_policy<DerivedPolicy> &exec,
                       InputIterator first,
                       InputIterator last,
-                      Predicate pred)
+                      Predicate pred,
+                      thrust::incrementable_traversal_tag)
 {
   // tbb prefers generic::find_if to cpp::find_if
   return thrust::system::detail::generic::find_if(exec, first, last, pred);
 }
 
+#if THRUST_CPP_DIALECT >= 2011
+template <typename DerivedPolicy, typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator find_if(execution_policy<DerivedPolicy> &,
+                             RandomAccessIterator first,
+                             RandomAccessIterator last,
+                             Predicate pred,
+                             thrust::random_access_traversal_tag)
+{
+  return thrust::system::detail::internal::early_exit_find_if(index_parallel_for(), first, last, pred);
+}
+#endif
+
+} // end find_detail
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+  return find_detail::find_if(exec, first, last, pred,
+    typename thrust::iterator_traversal<InputIterator>::type());
+}
+
 } // end namespace detail
 } // end namespace tbb
 } // end namespace system
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file index_parallel_for.h
+ *  \brief Invokes a function on every index of a range in parallel.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace index_parallel_for_detail
+{
+
+
+template<typename Size, typename Function>
+  struct body
+{
+  Function f;
+
+  body(Function f)
+    : f(f)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      f(i);
+    }
+  }
+};
+
+
+} // end index_parallel_for_detail
+
+
+// calls f(i) for every i in [0, n). This is the parallel loop which the
+// host systems pass to the drivers in thrust/system/detail/internal
+struct index_parallel_for
+{
+  template<typename Size, typename Function>
+  void operator()(Size n, Function f) const
+  {
+    ::tbb::parallel_for(::tbb::blocked_range<Size>(0, n, 1), index_parallel_for_detail::body<Size,Function>(f));
+  }
+};
+
+
+} // end detail
+} // end tbb
+} // end system
+} // end thrust
+
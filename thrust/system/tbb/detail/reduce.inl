@@ -23,6 +23,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
 #include <thrust/reduce.h>
+#include <thrust/system/detail/sequential/execution_policy.h>
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_reduce.h>
 
@@ -45,16 +46,17 @@ struct body
   RandomAccessIterator first;
   OutputType sum;
   bool first_call;  // TBB can invoke operator() multiple times on the same body
+  BinaryFunction op;
   thrust::detail::wrapped_function<BinaryFunction,OutputType> binary_op;
 
   // note: we only initalize sum with init to avoid calling OutputType's default constructor
   body(RandomAccessIterator first, OutputType init, BinaryFunction binary_op)
-    : first(first), sum(init), first_call(true), binary_op(binary_op)
+    : first(first), sum(init), first_call(true), op(binary_op), binary_op(binary_op)
   {}
 
   // note: we only initalize sum with b.sum to avoid calling OutputType's default constructor
   body(body& b, ::tbb::split)
-    : first(b.first), sum(b.sum), first_call(true), binary_op(b.binary_op)
+    : first(b.first), sum(b.sum), first_call(true), op(b.op), binary_op(b.op)
   {}
 
   template <typename Size>
@@ -68,10 +70,9 @@ struct body
 
     OutputType temp = thrust::raw_reference_cast(*iter);
 
-    ++iter;
-
-    for (Size i = r.begin() + 1; i != r.end(); ++i, ++iter)
-      temp = binary_op(temp, *iter);
+    // reduce the rest of the range with the sequential system, which
+    // vectorizes contiguous ranges of arithmetic types
+    temp = thrust::reduce(thrust::system::detail::sequential::seq, iter + 1, first + r.end(), temp, op);
 
 
     if (first_call)
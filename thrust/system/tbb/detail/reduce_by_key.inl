@@ -18,6 +18,9 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/tbb/detail/reduce_by_key.h>
+#include <thrust/system/tbb/detail/index_parallel_for.h>
+#include <thrust/system/detail/generic/reduce_by_key.h>
+#include <thrust/system/detail/internal/hash_reduce_by_key.h>
 #include <thrust/iterator/reverse_iterator.h>
 #include <thrust/detail/seq.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
@@ -335,6 +338,75 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
 }
 
 
+namespace reduce_by_key_detail
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_unsorted(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 keys_first,
+                           InputIterator1 keys_last,
+                           InputIterator2 values_first,
+                           OutputIterator1 keys_output,
+                           OutputIterator2 values_output,
+                           BinaryFunction binary_op,
+                           thrust::detail::false_type)
+{
+  // tbb prefers generic::reduce_by_key_unsorted to cpp::reduce_by_key_unsorted
+  return thrust::system::detail::generic::reduce_by_key_unsorted(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_op);
+} // end reduce_by_key_unsorted()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename BinaryFunction>
+  thrust::pair<RandomAccessIterator3,RandomAccessIterator4>
+    reduce_by_key_unsorted(execution_policy<DerivedPolicy> &exec,
+                           RandomAccessIterator1 keys_first,
+                           RandomAccessIterator1 keys_last,
+                           RandomAccessIterator2 values_first,
+                           RandomAccessIterator3 keys_output,
+                           RandomAccessIterator4 values_output,
+                           BinaryFunction binary_op,
+                           thrust::detail::true_type)
+{
+  return thrust::system::detail::internal::hash_reduce_by_key(exec, index_parallel_for(),
+    keys_first, keys_last, values_first, keys_output, values_output, binary_op);
+} // end reduce_by_key_unsorted()
+
+
+} // end reduce_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryFunction>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    reduce_by_key_unsorted(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 keys_first,
+                           InputIterator1 keys_last,
+                           InputIterator2 values_first,
+                           OutputIterator1 keys_output,
+                           OutputIterator2 values_output,
+                           BinaryFunction binary_op)
+{
+  return reduce_by_key_detail::reduce_by_key_unsorted(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_op,
+    typename thrust::system::detail::internal::use_hash_reduce_by_key<InputIterator1,InputIterator2,OutputIterator1,OutputIterator2>::type());
+} // end reduce_by_key_unsorted()
+
+
 } // end detail
 } // end tbb
 } // end system
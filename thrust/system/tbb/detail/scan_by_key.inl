@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/system/tbb/detail/scan_by_key.h>
+#include <thrust/system/tbb/detail/index_parallel_for.h>
+#include <thrust/system/detail/internal/tiled_scan_by_key.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_tiled_scan_by_key<RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3>::value,
+    RandomAccessIterator3
+  >::type
+    inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          RandomAccessIterator3 result,
+                          BinaryPredicate binary_pred,
+                          BinaryFunction binary_op)
+{
+  return thrust::system::detail::internal::tiled_inclusive_scan_by_key(exec, index_parallel_for(),
+    first1, last1, first2, result, binary_pred, binary_op);
+} // end inclusive_scan_by_key()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_tiled_scan_by_key<RandomAccessIterator1,RandomAccessIterator2,RandomAccessIterator3>::value,
+    RandomAccessIterator3
+  >::type
+    exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          RandomAccessIterator3 result,
+                          T init,
+                          BinaryPredicate binary_pred,
+                          BinaryFunction binary_op)
+{
+  return thrust::system::detail::internal::tiled_exclusive_scan_by_key(exec, index_parallel_for(),
+    first1, last1, first2, result, init, binary_pred, binary_op);
+} // end exclusive_scan_by_key()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
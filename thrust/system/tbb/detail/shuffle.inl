@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in ctbbliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/detail/cpp11_required.h>
+
+#if THRUST_CPP_DIALECT >= 2011
+
+#include <thrust/system/tbb/detail/shuffle.h>
+#include <thrust/system/tbb/detail/index_parallel_for.h>
+#include <thrust/system/detail/internal/bucket_shuffle.h>
+#include <thrust/iterator/iterator_traits.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename URBG>
+  void shuffle(execution_policy<DerivedPolicy> &exec,
+               RandomIterator first,
+               RandomIterator last,
+               URBG &&g)
+{
+  typedef typename thrust::iterator_value<RandomIterator>::type value_type;
+
+  thrust::system::detail::internal::bucket_shuffle(exec, index_parallel_for(), first, last, g,
+    thrust::system::detail::internal::bucket_shuffle_default_bucket_size<value_type>::value);
+} // end shuffle()
+
+
+template<typename DerivedPolicy,
+         typename RandomIterator,
+         typename OutputIterator,
+         typename URBG>
+  void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                    RandomIterator first,
+                    RandomIterator last,
+                    OutputIterator result,
+                    URBG &&g)
+{
+  typedef typename thrust::iterator_value<RandomIterator>::type value_type;
+
+  thrust::system::detail::internal::bucket_shuffle_copy(exec, index_parallel_for(), first, last, result, g,
+    thrust::system::detail::internal::bucket_shuffle_default_bucket_size<value_type>::value);
+} // end shuffle_copy()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
+#endif
+
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2020 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <thrust/detail/config.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/tbb/detail/transform.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace thrust
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace transform_detail
+{
+
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size,
+         typename UnaryFunction>
+  struct body
+{
+  RandomAccessIterator1 m_first;
+  RandomAccessIterator2 m_result;
+  UnaryFunction m_op;
+
+  body(RandomAccessIterator1 first, RandomAccessIterator2 result, UnaryFunction op)
+    : m_first(first), m_result(result), m_op(op)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    thrust::system::detail::internal::transform_prefetching_range(m_first, m_result, r.begin(), r.end(), m_op);
+  } // end operator()()
+}; // end body
+
+
+template<typename Size, typename RandomAccessIterator1, typename RandomAccessIterator2, typename UnaryFunction>
+  body<RandomAccessIterator1,RandomAccessIterator2,Size,UnaryFunction>
+    make_body(RandomAccessIterator1 first, RandomAccessIterator2 result, UnaryFunction op)
+{
+  return body<RandomAccessIterator1,RandomAccessIterator2,Size,UnaryFunction>(first, result, op);
+} // end make_body()
+
+
+} // end transform_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename UnaryFunction>
+  typename thrust::detail::enable_if<
+    thrust::system::detail::internal::use_prefetching_transform<RandomAccessIterator1,RandomAccessIterator2>::value,
+    RandomAccessIterator2
+  >::type
+    transform(execution_policy<DerivedPolicy> &,
+              RandomAccessIterator1 first,
+              RandomAccessIterator1 last,
+              RandomAccessIterator2 result,
+              UnaryFunction op)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type Size;
+
+  const Size n = last - first;
+
+  // use a grain size large enough for the prefetches to run ahead of the loads
+  const Size grain_size = 4 * THRUST_PREFETCH_DISTANCE;
+
+  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, n, grain_size), transform_detail::make_body<Size>(first, result, op));
+
+  return result + n;
+} // end transform()
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace thrust
+
@@ -18,7 +18,9 @@
 
 #include <thrust/detail/config.h>
 #include <thrust/system/tbb/detail/unique_by_key.h>
+#include <thrust/system/tbb/detail/index_parallel_for.h>
 #include <thrust/system/detail/generic/unique_by_key.h>
+#include <thrust/system/detail/internal/tiled_unique_by_key.h>
 #include <thrust/pair.h>
 
 namespace thrust
@@ -29,6 +31,8 @@ namespace tbb
 {
 namespace detail
 {
+namespace unique_by_key_detail
+{
 
 
 template<typename DerivedPolicy,
@@ -37,16 +41,34 @@ template<typename DerivedPolicy,
          typename BinaryPredicate>
   thrust::pair<ForwardIterator1,ForwardIterator2>
     unique_by_key(execution_policy<DerivedPolicy> &exec,
-                  ForwardIterator1 keys_first, 
+                  ForwardIterator1 keys_first,
                   ForwardIterator1 keys_last,
                   ForwardIterator2 values_first,
-                  BinaryPredicate binary_pred)
+                  BinaryPredicate binary_pred,
+                  thrust::detail::false_type)
 {
   // tbb prefers generic::unique_by_key to cpp::unique_by_key
   return thrust::system::detail::generic::unique_by_key(exec,keys_first,keys_last,values_first,binary_pred);
 } // end unique_by_key()
 
 
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename BinaryPredicate>
+  thrust::pair<RandomAccessIterator1,RandomAccessIterator2>
+    unique_by_key(execution_policy<DerivedPolicy> &exec,
+                  RandomAccessIterator1 keys_first,
+                  RandomAccessIterator1 keys_last,
+                  RandomAccessIterator2 values_first,
+                  BinaryPredicate binary_pred,
+                  thrust::detail::true_type)
+{
+  return thrust::system::detail::internal::tiled_unique_by_key(exec, index_parallel_for(),
+    keys_first, keys_last, values_first, binary_pred);
+} // end unique_by_key()
+
+
 template<typename DerivedPolicy,
          typename InputIterator1,
          typename InputIterator2,
@@ -55,18 +77,79 @@ template<typename DerivedPolicy,
          typename BinaryPredicate>
   thrust::pair<OutputIterator1,OutputIterator2>
     unique_by_key_copy(execution_policy<DerivedPolicy> &exec,
-                       InputIterator1 keys_first, 
+                       InputIterator1 keys_first,
                        InputIterator1 keys_last,
                        InputIterator2 values_first,
                        OutputIterator1 keys_output,
                        OutputIterator2 values_output,
-                       BinaryPredicate binary_pred)
+                       BinaryPredicate binary_pred,
+                       thrust::detail::false_type)
 {
   // tbb prefers generic::unique_by_key_copy to cpp::unique_by_key_copy
   return thrust::system::detail::generic::unique_by_key_copy(exec,keys_first,keys_last,values_first,keys_output,values_output,binary_pred);
 } // end unique_by_key_copy()
 
 
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename BinaryPredicate>
+  thrust::pair<RandomAccessIterator3,RandomAccessIterator4>
+    unique_by_key_copy(execution_policy<DerivedPolicy> &exec,
+                       RandomAccessIterator1 keys_first,
+                       RandomAccessIterator1 keys_last,
+                       RandomAccessIterator2 values_first,
+                       RandomAccessIterator3 keys_output,
+                       RandomAccessIterator4 values_output,
+                       BinaryPredicate binary_pred,
+                       thrust::detail::true_type)
+{
+  return thrust::system::detail::internal::tiled_unique_by_key_copy(exec, index_parallel_for(),
+    keys_first, keys_last, values_first, keys_output, values_output, binary_pred);
+} // end unique_by_key_copy()
+
+
+} // end unique_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename ForwardIterator1,
+         typename ForwardIterator2,
+         typename BinaryPredicate>
+  thrust::pair<ForwardIterator1,ForwardIterator2>
+    unique_by_key(execution_policy<DerivedPolicy> &exec,
+                  ForwardIterator1 keys_first, 
+                  ForwardIterator1 keys_last,
+                  ForwardIterator2 values_first,
+                  BinaryPredicate binary_pred)
+{
+  return unique_by_key_detail::unique_by_key(exec, keys_first, keys_last, values_first, binary_pred,
+    typename thrust::system::detail::internal::use_tiled_unique_by_key<ForwardIterator1,ForwardIterator2>::type());
+} // end unique_by_key()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename BinaryPredicate>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    unique_by_key_copy(execution_policy<DerivedPolicy> &exec,
+                       InputIterator1 keys_first, 
+                       InputIterator1 keys_last,
+                       InputIterator2 values_first,
+                       OutputIterator1 keys_output,
+                       OutputIterator2 values_output,
+                       BinaryPredicate binary_pred)
+{
+  return unique_by_key_detail::unique_by_key_copy(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_pred,
+    typename thrust::system::detail::internal::use_tiled_unique_by_key_copy<InputIterator1,InputIterator2,OutputIterator1,OutputIterator2>::type());
+} // end unique_by_key_copy()
+
+
 } // end namespace detail
 } // end namespace tbb
 } // end namespace system